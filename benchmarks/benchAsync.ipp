@@ -0,0 +1,53 @@
+#ifndef BENCH_ASYNC_IPP
+#define BENCH_ASYNC_IPP
+
+// Sink that throws everything away, so only the Cost of the Logger itself is measured
+class NullLogger : public BLogger {
+    protected:
+        inline void log(const std::string& message) override {
+            doNotOptimize(message.data());
+        }
+
+    public:
+        inline explicit NullLogger(const std::string& name) : BLogger(name) {}
+};
+
+inline void benchAsync() {
+    constexpr int RECORDS = 200000;
+
+    auto decorated = [](const std::string& name) {
+        return BLoglevelDecorator::decorate(BTimestampDecorator::decorate(std::make_shared<NullLogger>(name)));
+    };
+
+    {
+        auto lg = decorated("bench_sync");
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            (*lg)[BLogLevel::INFO] << "request " << i << " took " << 0.25 << "ms on " << "worker-3";
+        reportPerOp("sync chain (caller formats + decorates)", timer.seconds(), RECORDS);
+    }
+
+    {
+        auto async = BAsyncDecorator::decorate(decorated("bench_async"));
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            (*async)[BLogLevel::INFO] << "request " << i << " took " << 0.25 << "ms on " << "worker-3";
+        double producer = timer.seconds();
+        async->flushQueue();
+        reportPerOp("async chain (producer side)", producer, RECORDS);
+        reportPerOp("async chain (until drained)", timer.seconds(), RECORDS);
+    }
+
+    {
+        auto async = BAsyncDecorator::decorate(decorated("bench_deferred"));
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            BLOG_DEFERRED(async, "", BLogLevel::INFO) << "request " << i << " took " << 0.25 << "ms on " << "worker-3";
+        double producer = timer.seconds();
+        async->flushQueue();
+        reportPerOp("deferred (producer side)", producer, RECORDS);
+        reportPerOp("deferred (until drained)", timer.seconds(), RECORDS);
+    }
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef BENCH_COMPRESSED_IPP
+#define BENCH_COMPRESSED_IPP
+
+// Cost on the logging Thread and Size on Disk, Compression runs on the Writer-Thread
+inline void benchCompressed() {
+    constexpr int RECORDS = 200000;
+    const std::string path = "./bench_compressed_output.log";
+
+    auto run = [&](const std::string& name, std::shared_ptr<BLogger> sink) {
+        auto lg = BLoglevelDecorator::decorate(sink);
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            (*lg)[BLogLevel::INFO] << "request " << i << " handled by worker-" << i % 8;
+        double producer = timer.seconds();
+        lg->flush();
+        reportPerOp(name, producer, RECORDS);
+        std::cout << std::left << std::setw(40) << "  bytes on disk" << std::right << std::setw(10)
+                  << std::ifstream(path, std::ios::binary | std::ios::ate).tellg() << "\n";
+        std::remove(path.c_str());
+    };
+
+    std::remove(path.c_str());
+    run("BFileLogger", std::make_shared<BFileLogger>("bench_plain", path));
+    run(std::string("BCompressedFileLogger (") + BLogCodecs::preferred()->name() + ")",
+        std::make_shared<BCompressedFileLogger>("bench_compressed", path));
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef BENCH_FD_LOGGER_IPP
+#define BENCH_FD_LOGGER_IPP
+
+inline void benchFdLogger() {
+    constexpr int RECORDS = 200000;
+    const std::string path = "./bench_fd_output.log";
+
+    auto run = [&](const std::string& name, std::shared_ptr<BLogger> sink) {
+        auto lg = BLoglevelDecorator::decorate(sink);
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            (*lg)[BLogLevel::INFO] << "request " << i << " finished";
+        lg->flush();
+        reportPerOp(name, timer.seconds(), RECORDS);
+    };
+
+    std::remove(path.c_str());
+    run("BFileLogger (ofstream, flush per fragment)", std::make_shared<BFileLogger>("bench_file", path));
+    std::remove(path.c_str());
+    run("BFdLogger (writev per record)", std::make_shared<BFdLogger>("bench_fd", path));
+    std::remove(path.c_str());
+    run("BFdLogger (batched 64KB)", std::make_shared<BFdLogger>("bench_fd_batched", path, true, 64 * 1024));
+    std::remove(path.c_str());
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef BENCH_FORMAT_IPP
+#define BENCH_FORMAT_IPP
+
+// Same Record through the Chain (one log() + ostringstream per Fragment) and through BLOGF (one log())
+inline void benchFormat() {
+    constexpr int RECORDS = 500000;
+
+    {
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<NullLogger>("bench_format_chain"));
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            (*lg)[BLogLevel::INFO] << "request " << i << " took " << 0.25 << "ms on " << "worker-3";
+        reportPerOp("chain (6 fragments)", timer.seconds(), RECORDS);
+    }
+
+    {
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<NullLogger>("bench_format_blogf"));
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            BLOGF((*lg)[BLogLevel::INFO], "request {} took {}ms on {}", i, 0.25, "worker-3");
+        reportPerOp("BLOGF (compiled format)", timer.seconds(), RECORDS);
+    }
+
+    {
+        // The Threshold is looked up by the Name of the outermost Logger (the Decorator)
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<NullLogger>("bench_format_filtered"));
+        BLoggerConfig::setLoggerLevel(lg->getName(), BLogLevel::ERROR);
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            BLOGF((*lg)[BLogLevel::INFO], "request {} took {}ms on {}", i, 0.25, "worker-3");
+        reportPerOp("BLOGF (filtered)", timer.seconds(), RECORDS);
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef BENCH_POOL_IPP
+#define BENCH_POOL_IPP
+
+// Scaling of BAsyncDecorator with several Writers. When pinned, Producers and Writers get CPUs of their own,
+// taken from the Affinity-Mask of the Process. Only meaningful on Machines with enough Cores (ideally several Sockets)
+inline void benchPool() {
+    constexpr int RECORDS = 100000;             // per Producer
+    const std::vector<int> allowed = BLogNuma::allowedCpus();
+    std::cout << "Allowed CPUs " << allowed.size() << ", NUMA-Nodes " << BLogNuma::instance().nodeCount() << "\n";
+
+    for(bool affinity : {false, true}) {
+        double single = 0;
+        for(size_t threads : {1, 2, 4, 8}) {
+            std::string label = std::to_string(threads) + " writers/producers" + (affinity ? ", pinned" : "");
+            if(affinity && allowed.size() < 2 * threads) {
+                std::cout << std::left << std::setw(40) << label << " skipped, needs " << 2 * threads << " CPUs\n";
+                continue;
+            }
+
+            // Writer i on allowed[i], Producer i on allowed[threads + i]
+            BAsyncOptions options;
+            options.writers = threads;
+            if(affinity)
+                options.cpus.assign(allowed.begin(), allowed.begin() + threads);
+            auto pool = BAsyncDecorator::decorate(std::make_shared<NullLogger>("bench_pool_" + std::to_string(threads) + (affinity ? "_pinned" : "")), options);
+
+            std::atomic<size_t> pinnedProducers{0};
+            BenchTimer timer;
+            std::vector<std::thread> producers;
+            for(size_t i = 0; i < threads; i++) {
+                producers.emplace_back([&pool, &allowed, &pinnedProducers, affinity, threads, i]() {
+                    if(affinity && BLogNuma::pinCurrent(allowed[threads + i]))
+                        pinnedProducers++;
+                    for(int j = 0; j < RECORDS; j++)
+                        BLOG_DEFERRED(pool, "", BLogLevel::INFO) << "request " << j << " took " << 0.25 << "ms on worker-" << i;
+                });
+            }
+            for(auto& producer : producers)
+                producer.join();
+            pool->flushQueue();
+            double seconds = timer.seconds();
+
+            double perSecond = threads * RECORDS / seconds;
+            if(single == 0)
+                single = perSecond;
+            std::cout << std::left << std::setw(40) << label
+                      << std::right << std::setw(10) << std::fixed << std::setprecision(2) << perSecond / 1e6 << " M rec/s"
+                      << std::setw(8) << perSecond / single << "x";
+            if(affinity)
+                std::cout << "   pinned " << pool->pinnedWriters() << "/" << threads << " writers, " << pinnedProducers << "/" << threads << " producers";
+            std::cout << "\n";
+        }
+    }
+}
+
+#endif
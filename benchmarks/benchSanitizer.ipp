@@ -0,0 +1,68 @@
+#ifndef BENCH_SANITIZER_IPP
+#define BENCH_SANITIZER_IPP
+
+// Reference: the obvious byte by byte Loop (escape everything that is not printable ASCII)
+inline void naiveSanitize(const std::string& in, std::string& out) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    for(unsigned char c : in) {
+        if(c == '\n') out += "\\n";
+        else if(c == '\t') out += "\\t";
+        else if(c == '\r') out += "\\r";
+        else if(c == '\\') out += "\\\\";
+        else if(c < 0x20 || c >= 0x7F) { out += "\\x"; out += HEX[c >> 4]; out += HEX[c & 0xF]; }
+        else out += static_cast<char>(c);
+    }
+}
+
+inline void benchSanitizer() {
+    constexpr size_t SIZE = 64 * 1024 * 1024;
+    constexpr int ROUNDS = 5;
+
+    std::string clean(SIZE, 'x');
+    for(size_t i = 0; i < SIZE; i++)
+        clean[i] = static_cast<char>('a' + (i * 7) % 26);
+
+    // One Newline every 4KB, the typical "mostly clean" Payload
+    std::string sparse = clean;
+    for(size_t i = 4095; i < SIZE; i += 4096)
+        sparse[i] = '\n';
+
+    std::string out;
+    out.reserve(SIZE * 2);
+
+    auto run = [&](const std::string& name, const std::string& input, auto&& fn) {
+        fn(input, out);                     // Warmup + fault in the Output Pages
+        BenchTimer timer;
+        for(int r = 0; r < ROUNDS; r++) {
+            out.clear();
+            fn(input, out);
+            doNotOptimize(out.data());
+        }
+        report(name, timer.seconds(), double(input.size()) * ROUNDS);
+    };
+
+    auto scanSimd = [](const std::string& in, std::string&) {
+        doNotOptimize(BLoggerSanitizer::findUnsafe(in.data(), in.size()));
+    };
+    auto scanScalar = [](const std::string& in, std::string&) {
+        doNotOptimize(BLoggerSanitizer::findUnsafeScalar(in.data(), in.size()));
+    };
+    auto sanitize = [](const std::string& in, std::string& o) { BLoggerSanitizer::sanitize(in, o); };
+
+    #if defined(__AVX2__)
+        std::cout << "SIMD: AVX2\n";
+    #elif defined(__SSE2__)
+        std::cout << "SIMD: SSE2\n";
+    #else
+        std::cout << "SIMD: none (scalar fallback)\n";
+    #endif
+
+    run("scan clean (simd)", clean, scanSimd);
+    run("scan clean (scalar)", clean, scanScalar);
+    run("sanitize clean (simd)", clean, sanitize);
+    run("sanitize clean (byte loop)", clean, naiveSanitize);
+    run("sanitize sparse newlines (simd)", sparse, sanitize);
+    run("sanitize sparse newlines (byte loop)", sparse, naiveSanitize);
+}
+
+#endif
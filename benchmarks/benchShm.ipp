@@ -0,0 +1,34 @@
+#ifndef BENCH_SHM_IPP
+#define BENCH_SHM_IPP
+
+// Publishing into the Shared Memory Ring vs. writing the File directly, Collector on a Background-Thread
+inline void benchShm() {
+    constexpr int RECORDS = 200000;
+    const std::string ringName = "/blogger_bench_" + std::to_string(::getpid());
+    const std::string path = "./bench_shm_output.log";
+
+    BShmRing::remove(ringName);
+    std::remove(path.c_str());
+    {
+        BShmCollector collector({ringName}, path, 0);
+        collector.start();
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<BShmLogger>("bench_shm", ringName, BShmRing::Overflow::BLOCK));
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            (*lg)[BLogLevel::INFO] << "request " << i << " finished";
+        reportPerOp("BShmLogger (publish into ring)", timer.seconds(), RECORDS);
+    }
+    BShmRing::remove(ringName);
+    std::remove(path.c_str());
+
+    {
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<BFdLogger>("bench_shm_fd", path));
+        BenchTimer timer;
+        for(int i = 0; i < RECORDS; i++)
+            (*lg)[BLogLevel::INFO] << "request " << i << " finished";
+        reportPerOp("BFdLogger (writev per record)", timer.seconds(), RECORDS);
+    }
+    std::remove(path.c_str());
+}
+
+#endif
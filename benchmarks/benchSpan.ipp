@@ -0,0 +1,31 @@
+#ifndef BENCH_SPAN_IPP
+#define BENCH_SPAN_IPP
+
+inline void benchSpan() {
+    constexpr int SPANS = 1000000;
+
+    auto lg = std::make_shared<NullLogger>("bench_span");
+    BLoggerConfig::setTopics({"enabled"});
+    BLogTrace::clear();
+    BLogTrace::setCapacity(SPANS);          // Measure recording, not the dropping of a full Buffer
+
+    {
+        BenchTimer timer;
+        for(int i = 0; i < SPANS; i++)
+            BLogSpan span(lg, "hot path", "enabled");
+        reportPerOp("enabled span", timer.seconds(), SPANS);
+    }
+
+    {
+        BenchTimer timer;
+        for(int i = 0; i < SPANS; i++)
+            BLogSpan span(lg, "hot path", "disabled");
+        reportPerOp("disabled span (topic filtered)", timer.seconds(), SPANS);
+    }
+
+    BLoggerConfig::setTopics({});
+    BLogTrace::setCapacity(BLogTrace::DEFAULT_CAPACITY);
+    BLogTrace::clear();
+}
+
+#endif
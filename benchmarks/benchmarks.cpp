@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "../include/logger/blogSpan.hpp"
+#include "../include/logger/blogger.hpp"
+#include "../include/logger/bshmCollector.hpp"
+#include "../include/logger/bloggerFormat.hpp"
+#include "../include/logger/bloggerSanitizer.hpp"
+#include "../include/logger/decorators/basyncDecorator.hpp"
+#include "../include/logger/decorators/bloglevelDecorator.hpp"
+#include "../include/logger/decorators/btimestampDecorator.hpp"
+#include "../include/logger/loggers/bfdLogger.hpp"
+#include "../include/logger/loggers/bfileLogger.hpp"
+#include "../include/logger/loggers/bcompressedFileLogger.hpp"
+#include "../include/logger/loggers/bshmLogger.hpp"
+
+// Small Harness: every Benchmark reports its own Numbers, main only picks which ones to run
+struct BenchTimer {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Keep the Compiler from optimizing the measured Work away
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void report(const std::string& name, double seconds, double bytes) {
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << (bytes / seconds / 1e9) << " GB/s"
+              << std::setw(12) << std::setprecision(3) << (seconds * 1e3) << " ms\n";
+}
+
+inline void reportPerOp(const std::string& name, double seconds, double ops) {
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << (seconds / ops * 1e9) << " ns/op"
+              << std::setw(12) << std::setprecision(3) << (seconds * 1e3) << " ms\n";
+}
+
+#include "benchSanitizer.ipp"
+#include "benchAsync.ipp"
+#include "benchFdLogger.ipp"
+#include "benchFormat.ipp"
+#include "benchSpan.ipp"
+#include "benchShm.ipp"
+#include "benchCompressed.ipp"
+#include "benchPool.ipp"
+
+int main(int argc, char* argv[]) {
+    std::map<std::string, std::function<void()>> benches = {
+        {"sanitizer", benchSanitizer},
+        {"async", benchAsync},
+        {"fdlogger", benchFdLogger},
+        {"format", benchFormat},
+        {"span", benchSpan},
+        {"shm", benchShm},
+        {"compressed", benchCompressed},
+        {"pool", benchPool},
+    };
+
+    if(argc == 1) {
+        for(const auto& [name, bench] : benches) {
+            std::cout << "\n=== " << name << "\n";
+            bench();
+        }
+        return 0;
+    }
+
+    for(int i = 1; i < argc; i++) {
+        auto it = benches.find(argv[i]);
+        if(it == benches.end()) {
+            std::cout << "Unknown benchmark " << argv[i] << "\n";
+            continue;
+        }
+        std::cout << "\n=== " << it->first << "\n";
+        it->second();
+    }
+    return 0;
+}
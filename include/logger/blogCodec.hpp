@@ -0,0 +1,379 @@
+#ifndef BLOG_CODEC_HPP
+#define BLOG_CODEC_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// LZ4 and zstd are only used if asked for at Build-Time and their Headers are there, e.g.
+// -DBLOGGER_WITH_ZSTD -lzstd. Otherwise the built-in BLogLzCodec is the Fallback
+#if defined(BLOGGER_WITH_LZ4) && __has_include(<lz4.h>)
+    #include <lz4.h>
+    #define BLOGGER_HAS_LZ4 1
+#endif
+#if defined(BLOGGER_WITH_ZSTD) && __has_include(<zstd.h>)
+    #include <zstd.h>
+    #define BLOGGER_HAS_ZSTD 1
+#endif
+
+// Compresses one Block of Log-Output at a Time, every Block on its own (no Dictionary or State
+// carried over), so every Frame can be decoded without the ones in front of it
+class BLogCodec {
+    public:
+        // Stored in every Frame, never change the ID of an existing Codec
+        enum ID : uint8_t {
+            STORED = 0,
+            BUILTIN_LZ = 1,
+            LZ4 = 2,
+            ZSTD = 3
+        };
+
+        virtual ~BLogCodec() = default;
+
+        virtual ID id() const = 0;
+        virtual const char* name() const = 0;
+
+        // Append the compressed Form of data to out
+        virtual void compress(const char* data, size_t size, std::string& out) = 0;
+
+        // Append exactly rawSize Bytes to out, false if the Input is broken
+        virtual bool decompress(const char* data, size_t size, size_t rawSize, std::string& out) = 0;
+};
+
+class BLogStoredCodec : public BLogCodec {
+    public:
+        ID id() const override { return STORED; }
+        const char* name() const override { return "stored"; }
+
+        void compress(const char* data, size_t size, std::string& out) override {
+            out.append(data, size);
+        }
+
+        bool decompress(const char* data, size_t size, size_t rawSize, std::string& out) override {
+            if(size != rawSize)
+                return false;
+            out.append(data, size);
+            return true;
+        }
+};
+
+// Small LZ77 in the Style of the LZ4 Block-Format, no Dependencies. Log-Lines repeat a lot
+// (Prefixes, Timestamps, Messages), which is all it needs to get a good Ratio.
+// Sequence: Token (4 Bit Literal-Length, 4 Bit Match-Length - 4), extended Lengths as Runs of 255,
+// the Literals, 2 Byte Offset of the Match (up to 64KB back). The last Sequence only has Literals
+class BLogLzCodec : public BLogCodec {
+    private:
+        static constexpr int HASH_BITS = 14;
+        static constexpr size_t MIN_MATCH = 4;
+        static constexpr size_t MAX_OFFSET = 65535;
+
+        std::vector<uint32_t> table;            // Position + 1 of the last 4 Bytes with this Hash, 0 = none
+
+        inline static uint32_t read32(const char* at) {
+            uint32_t value;
+            std::memcpy(&value, at, sizeof(value));
+            return value;
+        }
+
+        inline static uint32_t hash(uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - HASH_BITS);
+        }
+
+        inline static void appendLength(std::string& out, size_t length) {
+            while(length >= 255) {
+                out += static_cast<char>(255);
+                length -= 255;
+            }
+            out += static_cast<char>(length);
+        }
+
+        inline static void emit(std::string& out, const char* literals, size_t literalLength, size_t offset, size_t matchLength) {
+            size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+            uint8_t token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+            if(matchLength > 0)
+                token |= static_cast<uint8_t>(matchCode < 15 ? matchCode : 15);
+            out += static_cast<char>(token);
+            if(literalLength >= 15)
+                appendLength(out, literalLength - 15);
+            out.append(literals, literalLength);
+
+            if(matchLength == 0)
+                return;                         // Last Sequence
+            out += static_cast<char>(offset & 0xff);
+            out += static_cast<char>(offset >> 8);
+            if(matchCode >= 15)
+                appendLength(out, matchCode - 15);
+        }
+
+        // Extended Length after a Nibble of 15, false if the Input ends in the Middle
+        inline static bool readLength(const unsigned char*& in, const unsigned char* end, size_t& length) {
+            unsigned char byte;
+            do {
+                if(in >= end)
+                    return false;
+                byte = *in++;
+                length += byte;
+            } while(byte == 255);
+            return true;
+        }
+
+    public:
+        ID id() const override { return BUILTIN_LZ; }
+        const char* name() const override { return "builtin-lz"; }
+
+        void compress(const char* data, size_t size, std::string& out) override {
+            table.assign(size_t(1) << HASH_BITS, 0);
+            size_t anchor = 0;
+            size_t pos = 0;
+
+            while(size >= MIN_MATCH && pos + MIN_MATCH <= size) {
+                uint32_t sequence = read32(data + pos);
+                uint32_t& slot = table[hash(sequence)];
+                size_t candidate = slot;
+                slot = static_cast<uint32_t>(pos + 1);
+
+                if(candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || read32(data + candidate - 1) != sequence) {
+                    pos++;
+                    continue;
+                }
+                candidate--;
+
+                size_t length = MIN_MATCH;
+                while(pos + length < size && data[candidate + length] == data[pos + length])
+                    length++;
+
+                emit(out, data + anchor, pos - anchor, pos - candidate, length);
+                pos += length;
+                anchor = pos;
+            }
+            emit(out, data + anchor, size - anchor, 0, 0);
+        }
+
+        bool decompress(const char* data, size_t size, size_t rawSize, std::string& out) override {
+            const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+            const unsigned char* end = in + size;
+            size_t start = out.size();
+            out.resize(start + rawSize);
+            char* dst = &out[start];
+            size_t written = 0;
+
+            while(in < end) {
+                uint8_t token = *in++;
+                size_t literalLength = token >> 4;
+                if(literalLength == 15 && !readLength(in, end, literalLength))
+                    break;
+                if(literalLength > static_cast<size_t>(end - in) || literalLength > rawSize - written)
+                    break;
+                std::memcpy(dst + written, in, literalLength);
+                in += literalLength;
+                written += literalLength;
+                if(written == rawSize)
+                    return in == end;
+
+                if(end - in < 2)
+                    break;
+                size_t offset = in[0] | (size_t(in[1]) << 8);
+                in += 2;
+                size_t matchLength = token & 0x0f;
+                if(matchLength == 15 && !readLength(in, end, matchLength))
+                    break;
+                matchLength += MIN_MATCH;
+                if(offset == 0 || offset > written || matchLength > rawSize - written)
+                    break;
+                // Byte by Byte, Matches may overlap with themselves (Runs)
+                for(size_t i = 0; i < matchLength; i++)
+                    dst[written + i] = dst[written - offset + i];
+                written += matchLength;
+            }
+            out.resize(start);
+            return rawSize == 0 && in == end;
+        }
+};
+
+#ifdef BLOGGER_HAS_LZ4
+class BLogLz4Codec : public BLogCodec {
+    public:
+        ID id() const override { return LZ4; }
+        const char* name() const override { return "lz4"; }
+
+        void compress(const char* data, size_t size, std::string& out) override {
+            size_t start = out.size();
+            out.resize(start + static_cast<size_t>(LZ4_compressBound(static_cast<int>(size))));
+            int written = LZ4_compress_default(data, &out[start], static_cast<int>(size), static_cast<int>(out.size() - start));
+            out.resize(start + static_cast<size_t>(written > 0 ? written : 0));
+        }
+
+        bool decompress(const char* data, size_t size, size_t rawSize, std::string& out) override {
+            size_t start = out.size();
+            out.resize(start + rawSize);
+            int written = LZ4_decompress_safe(data, &out[start], static_cast<int>(size), static_cast<int>(rawSize));
+            if(written < 0 || static_cast<size_t>(written) != rawSize) {
+                out.resize(start);
+                return false;
+            }
+            return true;
+        }
+};
+#endif
+
+#ifdef BLOGGER_HAS_ZSTD
+class BLogZstdCodec : public BLogCodec {
+    private:
+        int level;
+
+    public:
+        explicit BLogZstdCodec(int compressionLevel = 3) : level(compressionLevel) {}
+
+        ID id() const override { return ZSTD; }
+        const char* name() const override { return "zstd"; }
+
+        void compress(const char* data, size_t size, std::string& out) override {
+            size_t start = out.size();
+            out.resize(start + ZSTD_compressBound(size));
+            size_t written = ZSTD_compress(&out[start], out.size() - start, data, size, level);
+            out.resize(start + (ZSTD_isError(written) ? 0 : written));
+        }
+
+        bool decompress(const char* data, size_t size, size_t rawSize, std::string& out) override {
+            size_t start = out.size();
+            out.resize(start + rawSize);
+            size_t written = ZSTD_decompress(&out[start], rawSize, data, size);
+            if(ZSTD_isError(written) || written != rawSize) {
+                out.resize(start);
+                return false;
+            }
+            return true;
+        }
+};
+#endif
+
+class BLogCodecs {
+    public:
+        // Codec for an ID found in a Frame, nullptr if it was not built in
+        static std::unique_ptr<BLogCodec> create(uint8_t id) {
+            switch(id) {
+                case BLogCodec::STORED:     return std::make_unique<BLogStoredCodec>();
+                case BLogCodec::BUILTIN_LZ: return std::make_unique<BLogLzCodec>();
+                #ifdef BLOGGER_HAS_LZ4
+                case BLogCodec::LZ4:        return std::make_unique<BLogLz4Codec>();
+                #endif
+                #ifdef BLOGGER_HAS_ZSTD
+                case BLogCodec::ZSTD:       return std::make_unique<BLogZstdCodec>();
+                #endif
+                default:                    return nullptr;
+            }
+        }
+
+        // Best Codec this Build has: zstd, LZ4, then the built-in one
+        static std::unique_ptr<BLogCodec> preferred() {
+            #if defined(BLOGGER_HAS_ZSTD)
+                return create(BLogCodec::ZSTD);
+            #elif defined(BLOGGER_HAS_LZ4)
+                return create(BLogCodec::LZ4);
+            #else
+                return create(BLogCodec::BUILTIN_LZ);
+            #endif
+        }
+};
+
+// One Frame per Block:  [Header][compressed Payload]
+// The Checksum covers the uncompressed Block, so a torn or damaged Frame is never returned
+struct BLogFrameHeader {
+    static constexpr uint32_t MAGIC = 0x465a4c42;          // "BLZF"
+    static constexpr uint32_t MAX_BLOCK_BYTES = 64u << 20;  // Larger Blocks are written as several Frames
+
+    uint32_t magic;
+    uint8_t codec;
+    uint8_t reserved[3];
+    uint32_t rawSize;
+    uint32_t compressedSize;
+    uint32_t checksum;
+
+    // FNV-1a
+    inline static uint32_t checksumOf(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for(size_t i = 0; i < size; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+};
+
+static_assert(sizeof(BLogFrameHeader) == 20, "Frame Headers are written as they are");
+
+// Reads a File of Frames written by BCompressedFileLogger. Stops at the first incomplete or damaged Frame,
+// so a File of a crashed Process is readable up to its last complete Block
+class BLogFrameReader {
+    private:
+        std::ifstream file;
+        std::unique_ptr<BLogCodec> codecs[256];
+        std::string compressed;
+        bool broken = false;
+
+    public:
+        inline explicit BLogFrameReader(const std::string& path) : file(path, std::ios::binary) {
+            if(!file.is_open())
+                throw std::runtime_error("Could not open log file: " + path);
+        }
+
+        // Append the next Block to out, false at the End (or at a damaged Frame, see isBroken)
+        inline bool next(std::string& out) {
+            if(broken)
+                return false;
+
+            BLogFrameHeader header;
+            if(!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+                broken = file.gcount() != 0;            // Torn Header at the End
+                return false;
+            }
+            if(header.magic != BLogFrameHeader::MAGIC) {
+                broken = true;
+                return false;
+            }
+
+            // Sizes of a damaged Header must not decide how much is allocated. A Frame is stored as it is
+            // once compressing does not make it smaller, so the compressed Size is never above the raw one
+            std::streampos payload = file.tellg();
+            file.seekg(0, std::ios::end);
+            std::streamoff left = file.tellg() - payload;
+            file.seekg(payload);
+            if(header.rawSize > BLogFrameHeader::MAX_BLOCK_BYTES || header.compressedSize > header.rawSize
+                    || static_cast<std::streamoff>(header.compressedSize) > left) {
+                broken = true;
+                return false;
+            }
+
+            compressed.resize(header.compressedSize);
+            if(!file.read(&compressed[0], header.compressedSize)) {
+                broken = true;
+                return false;
+            }
+
+            std::unique_ptr<BLogCodec>& codec = codecs[header.codec];
+            if(!codec)
+                codec = BLogCodecs::create(header.codec);
+            if(!codec)
+                throw std::runtime_error("Log was written with a codec this build does not have (id " + std::to_string(header.codec) + ")");
+
+            size_t start = out.size();
+            if(!codec->decompress(compressed.data(), compressed.size(), header.rawSize, out)
+                || BLogFrameHeader::checksumOf(out.data() + start, header.rawSize) != header.checksum) {
+                out.resize(start);
+                broken = true;
+                return false;
+            }
+            return true;
+        }
+
+        // Did reading stop at a damaged or incomplete Frame instead of the clean End of the File?
+        inline bool isBroken() const {
+            return broken;
+        }
+};
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef BLOG_DEFERRED_RECORD_HPP
+#define BLOG_DEFERRED_RECORD_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "bloggerConfig.hpp"
+#include "bloggerMessage.hpp"
+
+// Static Description of one Log-Statement. Created once per Call-Site by BLOG_DEFERRED,
+// Records only carry a Pointer to it
+struct BLogCallsite {
+    const char* file;
+    int line;
+    BLogLevel level;
+    const char* topic;
+};
+
+// The raw Arguments of one Log-Statement, captured without formatting them.
+// Arguments are stored as [Tag][Payload] in a fixed inline Buffer:
+//  - Integers, Floats, Bools and Chars are copied bitwise
+//  - Strings are copied inline (Length + Bytes)
+//  - BLogMessages are serialized right away into the inline Buffer: no Allocation per Message, and a
+//    Message may point to Data that is gone once the Writer gets to it
+//  - Everything else is formatted right away as a Fallback
+// Once something does not fit inline anymore, it and everything after it is formatted right away
+// into an overflow String, so the Order of the Arguments is kept.
+// format() turns it into the final String, that is what the Writer-Thread does
+class BDeferredRecord {
+    public:
+        static constexpr size_t INLINE_BYTES = 128;
+
+    private:
+        enum class Tag : uint8_t {
+            INT,
+            UINT,
+            DOUBLE,
+            BOOL,
+            CHAR,
+            STRING
+        };
+
+        const BLogCallsite* site = nullptr;
+        uint16_t used = 0;
+        bool full = false;
+        unsigned char data[INLINE_BYTES];
+
+        // Rarely used, stays empty (and therefore allocation free) for the usual small Records
+        std::string overflow;
+
+        template<typename T>
+        inline bool pushRaw(Tag tag, const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable Payloads can be stored inline");
+            if(used + 1 + sizeof(T) > INLINE_BYTES)
+                return false;
+            data[used++] = static_cast<unsigned char>(tag);
+            std::memcpy(data + used, &value, sizeof(T));
+            used += sizeof(T);
+            return true;
+        }
+
+        inline bool pushString(std::string_view str) {
+            if(used + 1 + sizeof(uint16_t) + str.size() > INLINE_BYTES)
+                return false;
+            data[used++] = static_cast<unsigned char>(Tag::STRING);
+            uint16_t length = static_cast<uint16_t>(str.size());
+            std::memcpy(data + used, &length, sizeof(length));
+            used += sizeof(length);
+            std::memcpy(data + used, str.data(), str.size());
+            used += length;
+            return true;
+        }
+
+        template<typename T>
+        inline static T readRaw(const unsigned char* at) {
+            T value;
+            std::memcpy(&value, at, sizeof(T));
+            return value;
+        }
+
+        // Same Formatting as the Chain, used for the Fallback and the Overflow
+        template<typename T>
+        static void appendFormatted(std::string& out, const T& value) {
+            if constexpr(std::is_base_of<BLogMessage, T>::value) {
+                value.serializeTo(out);
+            } else if constexpr(std::is_convertible<const T&, std::string_view>::value) {
+                out += std::string_view(value);
+            } else {
+                std::ostringstream ss;
+                ss << value;
+                out += ss.str();
+            }
+        }
+
+        // Types that are copied as they are, everything else has to be formatted right away
+        template<typename V>
+        static constexpr bool storedRaw = !std::is_base_of<BLogMessage, V>::value
+            && (std::is_integral<V>::value || std::is_same<V, float>::value || std::is_same<V, double>::value
+                || std::is_convertible<const V&, std::string_view>::value);
+
+        template<typename T>
+        bool pushInline(T&& value) {
+            using V = std::decay_t<T>;
+
+            if constexpr(std::is_same<V, bool>::value) {
+                return pushRaw(Tag::BOOL, value);
+            } else if constexpr(std::is_same<V, char>::value || std::is_same<V, signed char>::value || std::is_same<V, unsigned char>::value) {
+                return pushRaw(Tag::CHAR, static_cast<char>(value));
+            } else if constexpr(std::is_integral<V>::value && std::is_signed<V>::value) {
+                return pushRaw(Tag::INT, static_cast<int64_t>(value));
+            } else if constexpr(std::is_integral<V>::value) {
+                return pushRaw(Tag::UINT, static_cast<uint64_t>(value));
+            } else if constexpr(std::is_same<V, float>::value || std::is_same<V, double>::value) {
+                return pushRaw(Tag::DOUBLE, static_cast<double>(value));
+            } else {
+                return pushString(std::string_view(value));
+            }
+        }
+
+    public:
+        BDeferredRecord() = default;
+        explicit BDeferredRecord(const BLogCallsite* callsite) : site(callsite) {}
+
+        BDeferredRecord(BDeferredRecord&& other) noexcept
+            : site(other.site), used(other.used), full(other.full),
+              overflow(std::move(other.overflow)) {
+            std::memcpy(data, other.data, used);        // Only the used Part
+        }
+
+        BDeferredRecord& operator=(BDeferredRecord&& other) noexcept {
+            site = other.site;
+            used = other.used;
+            full = other.full;
+            std::memcpy(data, other.data, used);
+            overflow = std::move(other.overflow);
+            return *this;
+        }
+
+        BDeferredRecord(const BDeferredRecord&) = delete;
+        BDeferredRecord& operator=(const BDeferredRecord&) = delete;
+
+        inline const BLogCallsite* callsite() const {
+            return site;
+        }
+
+        inline size_t inlineBytes() const {
+            return used;
+        }
+
+        // True once something had to be formatted right away because the inline Buffer was full
+        inline bool overflowed() const {
+            return full;
+        }
+
+        template<typename T>
+        void push(T&& value) {
+            using V = std::decay_t<T>;
+
+            if constexpr(storedRaw<V>) {
+                if(!full && pushInline(std::forward<T>(value)))
+                    return;
+                full = true;
+                appendFormatted(overflow, value);
+            } else if(full) {
+                appendFormatted(overflow, value);
+            } else {
+                // BLogMessage or unknown Type: formatted once, inline if it fits, otherwise into the Overflow
+                static thread_local std::string formatted;
+                formatted.clear();
+                appendFormatted(formatted, value);
+                if(pushString(formatted))
+                    return;
+                full = true;
+                overflow += formatted;
+            }
+        }
+
+        // Turn the captured Arguments into the final Message, meant to run on the Writer-Thread
+        void format(std::string& out) const {
+            std::ostringstream floatStream;     // Same Formatting as the Chain uses for Floats
+            size_t pos = 0;
+            while(pos < used) {
+                Tag tag = static_cast<Tag>(data[pos++]);
+                switch(tag) {
+                    case Tag::INT:
+                        out += std::to_string(readRaw<int64_t>(data + pos));
+                        pos += sizeof(int64_t);
+                        break;
+                    case Tag::UINT:
+                        out += std::to_string(readRaw<uint64_t>(data + pos));
+                        pos += sizeof(uint64_t);
+                        break;
+                    case Tag::DOUBLE:
+                        floatStream.str("");
+                        floatStream << readRaw<double>(data + pos);
+                        out += floatStream.str();
+                        pos += sizeof(double);
+                        break;
+                    case Tag::BOOL:
+                        out += readRaw<bool>(data + pos) ? "1" : "0";
+                        pos += sizeof(bool);
+                        break;
+                    case Tag::CHAR:
+                        out += static_cast<char>(data[pos]);
+                        pos += sizeof(char);
+                        break;
+                    case Tag::STRING: {
+                        uint16_t length = readRaw<uint16_t>(data + pos);
+                        pos += sizeof(uint16_t);
+                        out.append(reinterpret_cast<const char*>(data + pos), length);
+                        pos += length;
+                        break;
+                    }
+                }
+            }
+            out += overflow;
+        }
+};
+
+#endif
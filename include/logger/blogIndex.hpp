@@ -0,0 +1,276 @@
+#ifndef BLOG_INDEX_HPP
+#define BLOG_INDEX_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bloggerConfig.hpp"
+
+// Sidecar Index of a Log-File (<logfile>.idx), written by BFileLogger, read by BLogIndexReader / blogquery.
+//
+// The Log is cut into Blocks of whole Records: a new Block starts once blockBytes are reached or the
+// Time-Bucket (bucketMs) of the Record changes. For every Block one fixed Entry is appended:
+// Byte-Range, Time-Range, a Bitmap of the Levels and a 64 Bit Bloom-Filter of the Topics in it.
+// A Query only touches the Entries and then jumps straight to the matching Byte-Ranges of the Log,
+// at 16KB Blocks that is about 3MB of Index per GB of Log.
+// Results are whole Blocks that contain at least one matching Record, not single Records.
+//
+// The Entry of the open Block is written right when the Block starts and then rewritten in place, at most every
+// syncMs (checked per Record) and on flush(). After a Crash only the Records since the last Rewrite are missing
+// from the Index, blogquery prints that unindexed Tail of the Log unfiltered.
+// Times are never indexed below the newest one seen: if the Wall-Clock steps back, Records count as logged at the
+// Time before the Step until the Clock has caught up. That keeps the Entries sorted for the binary Search
+struct BLogIndexOptions {
+    size_t blockBytes = 16 * 1024;
+    uint32_t bucketMs = 1000;
+    uint32_t syncMs = 100;          // 0 rewrites the open Entry on every Record
+};
+
+struct BLogIndexBlock {
+    uint64_t offset;            // First Byte of the Block in the Log
+    uint64_t length;
+    int64_t firstMs;            // Wall-Clock (Unix-Epoch) of the first and last Record
+    int64_t lastMs;
+    uint32_t records;
+    uint32_t levels;            // Bit (1 << BLogLevel)
+    uint64_t topics;            // Bit BLogIndex::topicBit(topic) for every Topic
+};
+
+struct BLogIndexQuery {
+    int64_t fromMs = std::numeric_limits<int64_t>::min();
+    int64_t toMs = std::numeric_limits<int64_t>::max();
+    uint32_t levels = ~0u;      // Any of these Levels
+    uint64_t topics = 0;        // Any of these Topic-Bits, 0 matches every Topic
+};
+
+class BLogIndex {
+    public:
+        static constexpr char MAGIC[4] = {'B', 'L', 'I', 'X'};
+        static constexpr uint32_t VERSION = 1;
+
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+        };
+
+        static_assert(sizeof(BLogIndexBlock) == 48, "Index Entries are written as they are");
+
+        // FNV-1a of the Topic folded to one of 64 Bits
+        inline static uint64_t topicBit(std::string_view topic) {
+            uint64_t hash = 14695981039346656037ull;
+            for(char c : topic) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return 1ull << (hash % 64);
+        }
+
+        inline static uint32_t levelBit(BLogLevel level) {
+            return 1u << static_cast<uint32_t>(level);
+        }
+
+        inline static int64_t nowMs() {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+};
+
+// Collects the Records of the current Block, its Entry is rewritten in place until the Block is complete
+class BLogIndexWriter {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        BLogIndexOptions options;
+        int fd = -1;
+        BLogIndexBlock block{};
+        int64_t blockBucket = 0;
+        off_t entryOffset = 0;              // Where the Entry of the open Block goes
+        int64_t newestMs = std::numeric_limits<int64_t>::min();
+        Clock::time_point lastSync;
+
+        inline void writeAt(const void* data, size_t size, off_t at) {
+            const char* bytes = static_cast<const char*>(data);
+            while(size > 0) {
+                ssize_t written = ::pwrite(fd, bytes, size, at);
+                if(written < 0) {
+                    if(errno == EINTR)
+                        continue;
+                    return;
+                }
+                bytes += written;
+                at += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+
+    public:
+        inline BLogIndexWriter(const std::string& path, const BLogIndexOptions& indexOptions) : options(indexOptions) {
+            if(options.bucketMs == 0)
+                throw std::invalid_argument("Index bucket has to be at least 1ms");
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if(fd < 0)
+                throw std::runtime_error("Could not open index file: " + path + " (" + std::strerror(errno) + ")");
+
+            struct stat info;
+            off_t size = ::fstat(fd, &info) == 0 ? info.st_size : 0;
+            if(size < static_cast<off_t>(sizeof(BLogIndex::FileHeader))) {
+                BLogIndex::FileHeader header{{BLogIndex::MAGIC[0], BLogIndex::MAGIC[1], BLogIndex::MAGIC[2], BLogIndex::MAGIC[3]}, BLogIndex::VERSION};
+                writeAt(&header, sizeof(header), 0);
+                entryOffset = sizeof(header);
+                return;
+            }
+
+            // Continue after the last whole Entry (a half written one is overwritten), not before its Time
+            off_t entries = (size - static_cast<off_t>(sizeof(BLogIndex::FileHeader))) / static_cast<off_t>(sizeof(BLogIndexBlock));
+            entryOffset = static_cast<off_t>(sizeof(BLogIndex::FileHeader)) + entries * static_cast<off_t>(sizeof(BLogIndexBlock));
+            BLogIndexBlock last;
+            if(entries > 0 && ::pread(fd, &last, sizeof(last), entryOffset - static_cast<off_t>(sizeof(last))) == static_cast<ssize_t>(sizeof(last)))
+                newestMs = last.lastMs;
+        }
+
+        BLogIndexWriter(const BLogIndexWriter&) = delete;
+        BLogIndexWriter& operator=(const BLogIndexWriter&) = delete;
+
+        inline ~BLogIndexWriter() {
+            closeBlock();
+            ::close(fd);
+        }
+
+        // A Record was written to [offset, end) of the Log
+        inline void add(uint64_t offset, uint64_t end, BLogLevel level, const std::string& topic, int64_t timeMs) {
+            timeMs = std::max(timeMs, newestMs);
+            newestMs = timeMs;
+            int64_t bucket = timeMs / options.bucketMs;
+            if(block.records > 0 && (bucket != blockBucket || block.length >= options.blockBytes))
+                closeBlock();
+
+            if(block.records == 0) {
+                block.offset = offset;
+                block.firstMs = timeMs;
+                block.lastMs = timeMs;
+                blockBucket = bucket;
+            }
+            block.length = end - block.offset;
+            block.lastMs = std::max(block.lastMs, timeMs);
+            block.records++;
+            block.levels |= BLogIndex::levelBit(level);
+            block.topics |= BLogIndex::topicBit(topic);
+
+            if(block.records == 1 || Clock::now() - lastSync >= std::chrono::milliseconds(options.syncMs))
+                sync();
+        }
+
+        // Rewrites the Entry of the open Block, everything added so far is findable afterwards
+        inline void sync() {
+            if(block.records == 0)
+                return;
+            writeAt(&block, sizeof(block), entryOffset);
+            lastSync = Clock::now();
+        }
+
+        // Writes the Entry of the current Block (if any) a last Time, the next Record starts a new one
+        inline void closeBlock() {
+            if(block.records == 0)
+                return;
+            sync();
+            entryOffset += static_cast<off_t>(sizeof(block));
+            block = BLogIndexBlock{};
+        }
+};
+
+// Maps the Index read only and answers Queries on it
+class BLogIndexReader {
+    private:
+        int fd = -1;
+        void* memory = MAP_FAILED;
+        size_t mappedBytes = 0;
+        const BLogIndexBlock* blocks = nullptr;
+        size_t count = 0;
+
+    public:
+        inline explicit BLogIndexReader(const std::string& path) {
+            fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if(fd < 0)
+                throw std::runtime_error("Could not open index file: " + path + " (" + std::strerror(errno) + ")");
+            struct stat info;
+            if(::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(BLogIndex::FileHeader)) {
+                ::close(fd);
+                throw std::runtime_error("Not an index file: " + path);
+            }
+            mappedBytes = static_cast<size_t>(info.st_size);
+            memory = ::mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+            if(memory == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Could not map index file: " + path);
+            }
+
+            const auto* header = static_cast<const BLogIndex::FileHeader*>(memory);
+            if(std::memcmp(header->magic, BLogIndex::MAGIC, sizeof(header->magic)) != 0 || header->version != BLogIndex::VERSION) {
+                ::munmap(memory, mappedBytes);
+                ::close(fd);
+                throw std::runtime_error("Not an index file: " + path);
+            }
+            blocks = reinterpret_cast<const BLogIndexBlock*>(static_cast<const char*>(memory) + sizeof(BLogIndex::FileHeader));
+            count = (mappedBytes - sizeof(BLogIndex::FileHeader)) / sizeof(BLogIndexBlock);     // A half written Entry is ignored
+        }
+
+        BLogIndexReader(const BLogIndexReader&) = delete;
+        BLogIndexReader& operator=(const BLogIndexReader&) = delete;
+
+        inline ~BLogIndexReader() {
+            if(memory != MAP_FAILED)
+                ::munmap(memory, mappedBytes);
+            if(fd >= 0)
+                ::close(fd);
+        }
+
+        inline size_t size() const {
+            return count;
+        }
+
+        inline const BLogIndexBlock& operator[](size_t i) const {
+            return blocks[i];
+        }
+
+        // First Byte of the Log after the last indexed Block. Anything behind it was written after the last
+        // Sync of the Index (or before a Crash) and has to be read unfiltered
+        inline uint64_t indexedEnd() const {
+            return count > 0 ? blocks[count - 1].offset + blocks[count - 1].length : 0;
+        }
+
+        // Byte-Ranges of the Log (offset, length) with Blocks that may contain matching Records, adjacent ones merged.
+        // Blocks are appended in Time-Order, so the Start is found by binary Search
+        inline std::vector<std::pair<uint64_t, uint64_t>> query(const BLogIndexQuery& q) const {
+            std::vector<std::pair<uint64_t, uint64_t>> ranges;
+            const BLogIndexBlock* first = std::lower_bound(blocks, blocks + count, q.fromMs,
+                [](const BLogIndexBlock& block, int64_t from) { return block.lastMs < from; });
+
+            for(const BLogIndexBlock* block = first; block != blocks + count && block->firstMs <= q.toMs; block++) {
+                if(!(block->levels & q.levels))
+                    continue;
+                if(q.topics != 0 && !(block->topics & q.topics))
+                    continue;
+                if(!ranges.empty() && ranges.back().first + ranges.back().second == block->offset)
+                    ranges.back().second += block->length;
+                else
+                    ranges.emplace_back(block->offset, block->length);
+            }
+            return ranges;
+        }
+};
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef BLOG_NUMA_HPP
+#define BLOG_NUMA_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+    #include <dirent.h>
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+// CPU -> NUMA-Node Mapping and Thread-Pinning for the Writers of a BAsyncDecorator (Linux).
+// The Topology is read once from /sys/devices/system/node, without it (or on other Systems)
+// everything is treated as one Node and pinning does nothing
+class BLogNuma {
+    private:
+        std::vector<int> nodeOfCpu;             // Index is the CPU, -1 if unknown
+        int nodes = 1;
+
+        BLogNuma() = default;
+
+        inline static BLogNuma fromSystem() {
+            std::map<int, std::string> cpuLists;
+            #ifdef __linux__
+                DIR* dir = ::opendir("/sys/devices/system/node");
+                if(!dir)
+                    return BLogNuma();
+                while(dirent* entry = ::readdir(dir)) {
+                    std::string name = entry->d_name;
+                    if(name.compare(0, 4, "node") != 0 || name.size() == 4 || name.find_first_not_of("0123456789", 4) != std::string::npos)
+                        continue;
+                    std::ifstream cpulist("/sys/devices/system/node/" + name + "/cpulist");
+                    std::getline(cpulist, cpuLists[std::stoi(name.substr(4))]);
+                }
+                ::closedir(dir);
+            #endif
+            return fromCpuLists(cpuLists);
+        }
+
+    public:
+        // "0-3,8-11" -> CPUs. Empty and broken Entries (e.g. the empty List of a Node without CPUs) are skipped
+        inline static std::vector<int> parseCpuList(const std::string& list) {
+            std::vector<int> cpus;
+            size_t pos = 0;
+            while(pos < list.size()) {
+                size_t end = list.find(',', pos);
+                if(end == std::string::npos)
+                    end = list.size();
+                std::string range = list.substr(pos, end - pos);
+                size_t dash = range.find('-');
+                try {
+                    int first = std::stoi(range.substr(0, dash));
+                    int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                    for(int cpu = first; cpu <= last; cpu++)
+                        cpus.push_back(cpu);
+                } catch(const std::exception&) { }
+                pos = end + 1;
+            }
+            return cpus;
+        }
+
+        // Topology from the cpulist of every Node (Node-ID -> "0-3,8-11"), what the System-Lookup is built on
+        inline static BLogNuma fromCpuLists(const std::map<int, std::string>& cpuLists) {
+            BLogNuma topology;
+            int highest = -1;
+            for(const auto& [node, list] : cpuLists) {
+                for(int cpu : parseCpuList(list)) {
+                    if(cpu >= static_cast<int>(topology.nodeOfCpu.size()))
+                        topology.nodeOfCpu.resize(cpu + 1, -1);
+                    topology.nodeOfCpu[cpu] = node;
+                }
+                highest = std::max(highest, node);
+            }
+            topology.nodes = highest + 1 > 0 ? highest + 1 : 1;
+            return topology;
+        }
+
+        inline static const BLogNuma& instance() {
+            static const BLogNuma topology = fromSystem();
+            return topology;
+        }
+
+        // Highest Node-ID + 1. IDs can have Gaps and Nodes can be without CPUs (e.g. Memory-only Nodes)
+        inline int nodeCount() const {
+            return nodes;
+        }
+
+        // Node 0 for CPUs the Topology does not know
+        inline int nodeOf(int cpu) const {
+            if(cpu < 0 || cpu >= static_cast<int>(nodeOfCpu.size()) || nodeOfCpu[cpu] < 0)
+                return 0;
+            return nodeOfCpu[cpu];
+        }
+
+        // Node of the CPU the calling Thread runs on right now
+        inline int currentNode() const {
+            #ifdef __linux__
+                return nodeOf(::sched_getcpu());
+            #else
+                return 0;
+            #endif
+        }
+
+        // CPUs the calling Thread may run on (its Affinity-Mask), empty if unknown
+        inline static std::vector<int> allowedCpus() {
+            std::vector<int> cpus;
+            #ifdef __linux__
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                if(::sched_getaffinity(0, sizeof(set), &set) != 0)
+                    return cpus;
+                for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                    if(CPU_ISSET(cpu, &set))
+                        cpus.push_back(cpu);
+                }
+            #endif
+            return cpus;
+        }
+
+        // Pin the calling Thread to one CPU, false if that did not work (e.g. CPU not in the allowed Set)
+        inline static bool pinCurrent(int cpu) {
+            #ifdef __linux__
+                if(cpu < 0 || cpu >= CPU_SETSIZE)
+                    return false;
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+            #else
+                (void) cpu;
+                return false;
+            #endif
+        }
+};
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef BLOG_SPAN_HPP
+#define BLOG_SPAN_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "blogger.hpp"
+#include "bloggerConfig.hpp"
+
+// Collects the finished BLogSpans of all Threads and writes them as Chrome Trace Event JSON
+// (open it in chrome://tracing or ui.perfetto.dev).
+//
+// Every Thread writes into its own Buffer, the only Lock on the Way is the (uncontended) one of that Buffer.
+// A Buffer holds at most capacity() Events, Spans ending on a full Buffer are only counted (see dropped()).
+// Buffers outlive their Thread, so Spans of finished Threads are still exported. Once such a Buffer is
+// drained or cleared it is freed
+class BLogTrace {
+    public:
+        // Name and Topic point to the Strings given to BLogSpan (the Literals of the Call-Site), nothing is copied
+        struct Event {
+            std::string_view name;
+            std::string_view topic;
+            BLogLevel level;
+            uint32_t tid;
+            uint32_t depth;             // Number of Spans that were open around this one on the same Thread
+            uint64_t beginNs;           // Since the first Use of BLogTrace, monotonic
+            uint64_t durationNs;
+        };
+
+        static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    private:
+        struct ThreadBuffer {
+            std::mutex mutex;
+            uint32_t tid;
+            uint32_t openSpans = 0;     // Only touched by the owning Thread
+            bool exited = false;        // Owning Thread is gone, the Buffer is freed once it is empty
+            std::vector<Event> events;
+        };
+
+        // Owned by the Thread, marks its Buffer when the Thread ends
+        struct ThreadHandle {
+            std::shared_ptr<ThreadBuffer> buffer;
+
+            ~ThreadHandle() {
+                std::lock_guard<std::mutex> lock(buffer->mutex);
+                buffer->exited = true;
+            }
+        };
+
+        static std::mutex& registryMutex() {
+            static std::mutex registryMutex;
+            return registryMutex;
+        }
+
+        static std::vector<std::shared_ptr<ThreadBuffer>>& registry() {
+            static std::vector<std::shared_ptr<ThreadBuffer>> registry;
+            return registry;
+        }
+
+        static std::atomic<size_t>& maxEvents() {
+            static std::atomic<size_t> maxEvents{DEFAULT_CAPACITY};
+            return maxEvents;
+        }
+
+        static std::atomic<uint64_t>& droppedEvents() {
+            static std::atomic<uint64_t> droppedEvents{0};
+            return droppedEvents;
+        }
+
+        static std::chrono::steady_clock::time_point origin() {
+            static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+            return origin;
+        }
+
+        // Called with the registryMutex held
+        static void pruneExited() {
+            auto& buffers = registry();
+            buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                std::lock_guard<std::mutex> lock(buffer->mutex);
+                return buffer->exited && buffer->events.empty();
+            }), buffers.end());
+        }
+
+        inline static void appendEscaped(std::string& out, std::string_view text) {
+            for(char c : text) {
+                switch(c) {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if(static_cast<unsigned char>(c) < 0x20) {
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                            out += escaped;
+                        } else {
+                            out += c;
+                        }
+                }
+            }
+        }
+
+        // Microseconds with Nanosecond Precision, the Unit of the Trace-Format
+        inline static void appendMicros(std::string& out, uint64_t ns) {
+            char micros[32];
+            std::snprintf(micros, sizeof(micros), "%llu.%03llu",
+                static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+            out += micros;
+        }
+
+    public:
+        // Buffer of the calling Thread, created and registered on first Use
+        static ThreadBuffer& threadBuffer() {
+            static thread_local ThreadHandle handle{[]() {
+                static uint32_t nextTid = 0;        // Guarded by the registryMutex, Ids are never reused
+                auto created = std::make_shared<ThreadBuffer>();
+                created->events.reserve(256);
+                std::lock_guard<std::mutex> lock(registryMutex());
+                pruneExited();
+                created->tid = ++nextTid;
+                registry().push_back(created);
+                return created;
+            }()};
+            return *handle.buffer;
+        }
+
+        // Called by BLogSpan on the owning Thread
+        static void record(ThreadBuffer& buffer, const Event& event) {
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+            if(buffer.events.size() >= maxEvents().load(std::memory_order_relaxed)) {
+                droppedEvents().fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            buffer.events.push_back(event);
+        }
+
+        // Events kept per Thread until they are drained or cleared, applies to Spans ending from now on
+        static void setCapacity(size_t eventsPerThread) {
+            if(eventsPerThread == 0)
+                throw std::invalid_argument("Trace capacity must be at least 1");
+            maxEvents().store(eventsPerThread, std::memory_order_relaxed);
+        }
+
+        static size_t capacity() {
+            return maxEvents().load(std::memory_order_relaxed);
+        }
+
+        // Spans that ended on a full Buffer since the Start (or the last clear())
+        static uint64_t dropped() {
+            return droppedEvents().load(std::memory_order_relaxed);
+        }
+
+        // Registered Buffers, the ones of finished Threads included until they are drained
+        static size_t threadBuffers() {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            return registry().size();
+        }
+
+        inline static uint64_t now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - origin()).count());
+        }
+
+        // Copy of all Events recorded so far, per Thread in the Order the Spans ended
+        static std::vector<Event> collect() {
+            std::vector<Event> all;
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for(auto& buffer : registry()) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                all.insert(all.end(), buffer->events.begin(), buffer->events.end());
+            }
+            return all;
+        }
+
+        // Like collect(), but takes the Events out of the Buffers, so a long running Process can export
+        // periodically without running into the capacity()
+        static std::vector<Event> drain() {
+            std::vector<Event> all;
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for(auto& buffer : registry()) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                all.insert(all.end(), buffer->events.begin(), buffer->events.end());
+                buffer->events.clear();
+            }
+            pruneExited();
+            return all;
+        }
+
+        static void clear() {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for(auto& buffer : registry()) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                buffer->events.clear();
+            }
+            pruneExited();
+            droppedEvents().store(0, std::memory_order_relaxed);
+        }
+
+        // Complete Events ("ph":"X"), Nesting is derived by the Viewer from Timestamps and Durations per Thread
+        static std::string toJson() {
+            std::string json = "{\"traceEvents\":[";
+            std::string pid = std::to_string(::getpid());
+            bool first = true;
+            for(const Event& event : collect()) {
+                json += first ? "\n" : ",\n";
+                first = false;
+                json += "{\"name\":\"";
+                appendEscaped(json, event.name);
+                json += "\",\"cat\":\"";
+                appendEscaped(json, event.topic.empty() ? std::string_view("default") : event.topic);
+                json += "\",\"ph\":\"X\",\"ts\":";
+                appendMicros(json, event.beginNs);
+                json += ",\"dur\":";
+                appendMicros(json, event.durationNs);
+                json += ",\"pid\":" + pid + ",\"tid\":" + std::to_string(event.tid);
+                json += ",\"args\":{\"level\":\"" + LEVEL_TO_STRING.at(event.level) + "\",\"depth\":" + std::to_string(event.depth) + "}}";
+            }
+            json += "\n],\"displayTimeUnit\":\"ns\"}\n";
+            return json;
+        }
+
+        static void writeJson(std::ostream& out) {
+            out << toJson();
+        }
+
+        static void writeJson(const std::string& path) {
+            std::ofstream file(path, std::ios::trunc);
+            if(!file)
+                throw std::runtime_error("Could not open trace file: " + path);
+            writeJson(file);
+        }
+};
+
+// Times the Scope it lives in. Filtered like a Record of the given Logger, Level and Topic:
+// a disabled Span does not read the Clock and records nothing.
+// Name and Topic are not copied, they have to outlive the Export (String-Literals of the Call-Site do).
+//
+// {
+//     BLogSpan span(logger, "parse request", "network");
+//     {
+//         BLogSpan inner(logger, "decode body", "network", BLogLevel::DEBUG);
+//     }
+// }
+// BLogTrace::writeJson("./log/trace.json");
+class BLogSpan {
+    private:
+        const char* name;
+        const char* topic;
+        BLogLevel level;
+        uint64_t beginNs = 0;
+        uint32_t depth = 0;
+        bool active;
+
+    public:
+        inline BLogSpan(const BLogger& logger, const char* spanName, const char* spanTopic = "", BLogLevel spanLevel = BLogLevel::INFO)
+            : name(spanName), topic(spanTopic), level(spanLevel), active(logger.isEnabled(spanLevel, spanTopic)) {
+            if(!active)
+                return;
+            depth = BLogTrace::threadBuffer().openSpans++;
+            beginNs = BLogTrace::now();
+        }
+
+        inline BLogSpan(const std::shared_ptr<BLogger>& logger, const char* spanName, const char* spanTopic = "", BLogLevel spanLevel = BLogLevel::INFO)
+            : BLogSpan(*logger, spanName, spanTopic, spanLevel) {}
+
+        // Bound to the Scope and Thread it was opened in
+        BLogSpan(const BLogSpan&) = delete;
+        BLogSpan& operator=(const BLogSpan&) = delete;
+
+        inline ~BLogSpan() {
+            end();
+        }
+
+        // End the Span before the Scope ends. Called again (or by the Destructor) it does nothing
+        inline void end() {
+            if(!active)
+                return;
+            active = false;
+
+            uint64_t endNs = BLogTrace::now();
+            auto& buffer = BLogTrace::threadBuffer();
+            buffer.openSpans--;
+            BLogTrace::record(buffer, BLogTrace::Event{name, topic, level, buffer.tid, depth, beginNs, endNs - beginNs});
+        }
+
+        inline bool isActive() const {
+            return active;
+        }
+};
+
+#endif
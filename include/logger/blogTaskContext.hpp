@@ -0,0 +1,166 @@
+#ifndef BLOG_TASK_CONTEXT_HPP
+#define BLOG_TASK_CONTEXT_HPP
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "blogger.hpp"
+#include "bloggerConfig.hpp"
+#include "bloggerMessage.hpp"
+
+// Like BLogContext, but made for Tasks and Coroutines that might resume on another Thread.
+// It is a plain Value (copy or move it into the Task / Coroutine Frame) and carries everything
+// a Record needs: Topic, Level, Request-ID and additional Fields.
+// Records are built locally in the returned Record-Object and handed to the Logger in one single
+// Call (BLogger::logRecord) - no thread_local State (condition, lastMessage, Location) is involved,
+// so a Record may even be started on one Thread and finished on another.
+//
+// ctx.info() << "Request done in " << ms << "ms";
+// -> [req=4711] [user=bob] Request done in 12ms
+class BLogTaskContext {
+    private:
+        std::shared_ptr<BLogger> logger;
+        std::string topic;
+        BLogLevel level;
+        std::string requestId;
+        std::vector<std::pair<std::string, std::string>> fields;
+
+        template<typename T>
+        static void append(std::string& buffer, const T& value) {
+            if constexpr(std::is_base_of<BLogMessage, T>::value) {
+                value.serializeTo(buffer);
+            } else if constexpr(std::is_convertible<const T&, std::string_view>::value) {
+                buffer += std::string_view(value);
+            } else {
+                std::ostringstream ss;
+                ss << value;
+                buffer += ss.str();
+            }
+        }
+
+    public:
+        // Collects one Record, logs it when destroyed. Move-only, so it can be kept alive across
+        // a suspension Point if a Record should be built up in several Steps
+        class Record {
+            private:
+                std::shared_ptr<BLogger> logger;        // Nullptr if filtered -> everything is a No-Op
+                std::string topic;
+                BLogLevel level;
+                std::string buffer;
+
+            public:
+                Record(const BLogTaskContext& ctx, BLogLevel lvl) : level(lvl) {
+                    if(!ctx.logger || !ctx.logger->isEnabled(level, ctx.topic))
+                        return;
+
+                    // Copy what we need, the Record may outlive the Context it was started from
+                    logger = ctx.logger;
+                    topic = ctx.topic;
+                    if(!ctx.requestId.empty()) {
+                        buffer += "[req=";
+                        buffer += ctx.requestId;
+                        buffer += "] ";
+                    }
+                    for(const auto& [key, value] : ctx.fields) {
+                        buffer += "[";
+                        buffer += key;
+                        buffer += "=";
+                        buffer += value;
+                        buffer += "] ";
+                    }
+                }
+
+                Record(Record&& other) noexcept
+                    : logger(std::move(other.logger)), topic(std::move(other.topic)), level(other.level), buffer(std::move(other.buffer)) {
+                    other.logger = nullptr;
+                }
+
+                Record(const Record&) = delete;
+                Record& operator=(const Record&) = delete;
+                Record& operator=(Record&&) = delete;
+
+                ~Record() {
+                    if(logger)
+                        logger->logRecord(level, topic, buffer);
+                }
+
+                template<typename T>
+                Record& operator<<(const T& value) {
+                    if(logger)
+                        append(buffer, value);
+                    return *this;
+                }
+
+                bool enabled() const {
+                    return logger != nullptr;
+                }
+        };
+
+        BLogTaskContext(std::shared_ptr<BLogger> l, std::string defaultTopic = "", BLogLevel defaultLevel = BLogLevel::INFO, std::string reqId = "")
+            : logger(std::move(l)), topic(std::move(defaultTopic)), level(defaultLevel), requestId(std::move(reqId)) {
+            if(!logger)
+                throw std::invalid_argument("Logger cannot be null");
+        }
+
+        BLogTaskContext(const BLogTaskContext&) = default;
+        BLogTaskContext(BLogTaskContext&&) noexcept = default;
+        BLogTaskContext& operator=(const BLogTaskContext&) = default;
+        BLogTaskContext& operator=(BLogTaskContext&&) noexcept = default;
+
+        // Derive a new Context, e.g. for a Subtask. The Original stays untouched
+        template<typename T>
+        BLogTaskContext withField(std::string key, const T& value) const {
+            BLogTaskContext copy(*this);
+            std::string strValue;
+            append(strValue, value);
+            copy.fields.emplace_back(std::move(key), std::move(strValue));
+            return copy;
+        }
+
+        BLogTaskContext withRequestId(std::string reqId) const {
+            BLogTaskContext copy(*this);
+            copy.requestId = std::move(reqId);
+            return copy;
+        }
+
+        BLogTaskContext withTopic(std::string newTopic) const {
+            BLogTaskContext copy(*this);
+            copy.topic = std::move(newTopic);
+            return copy;
+        }
+
+        BLogTaskContext withLevel(BLogLevel newLevel) const {
+            BLogTaskContext copy(*this);
+            copy.level = newLevel;
+            return copy;
+        }
+
+        template<typename T>
+        Record operator<<(const T& value) const {
+            Record record(*this, level);
+            record << value;
+            return record;
+        }
+
+        Record at(BLogLevel lvl) const { return Record(*this, lvl); }
+        Record none() const { return at(BLogLevel::NONE); }
+        Record debug() const { return at(BLogLevel::DEBUG); }
+        Record log() const { return at(BLogLevel::LOG); }
+        Record info() const { return at(BLogLevel::INFO); }
+        Record warning() const { return at(BLogLevel::WARNING); }
+        Record error() const { return at(BLogLevel::ERROR); }
+
+        const std::string& getTopic() const { return topic; }
+        BLogLevel getLevel() const { return level; }
+        const std::string& getRequestId() const { return requestId; }
+        const std::vector<std::pair<std::string, std::string>>& getFields() const { return fields; }
+        const std::shared_ptr<BLogger>& ptr() const { return logger; }
+};
+
+#endif
@@ -6,6 +6,8 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <atomic>
 
 #include "bloggerConfig.hpp"
@@ -13,6 +15,22 @@
 
 class BLoggerDecorator;
 
+// One finished Record as a List of Pieces: Prefixes of the Decorators followed by the Body (no Newline).
+// Lets Decorators hand their Prefix down without concatenating it in front of the Message
+using BLogSegments = std::vector<std::string_view>;
+
+// A Value on Cache-Lines of its own. alignas on a Variable only aligns where it starts, the Rest of the Line
+// can still be used by whatever comes next. Here the Size is rounded up to a Multiple of 64 Bytes as well
+template<typename T>
+struct alignas(64) BLogCacheLine {
+    T value;
+
+    T* operator->() { return &value; }
+    const T* operator->() const { return &value; }
+    T& operator*() { return value; }
+    const T& operator*() const { return value; }
+};
+
 struct BLogger {
     // Allow the decorator as a friend so we can call the "log" function to prevent a superfluous "newline"
     friend class BLoggerDecorator;
@@ -23,7 +41,7 @@ struct BLogger {
 
     protected:
         BLogger(const std::string& loggerName) :
-            name(std::move(loggerName)), instanceID(++instance_counter) { }
+            name(std::move(loggerName)), instanceID(++instance_counter.value) { }
 
         const std::string name;
         const ID instanceID;
@@ -31,8 +49,10 @@ struct BLogger {
         // https://isocpp.org/wiki/faq/ctors#static-init-order
         // Use Static Function in order to Prevent static init order
 
+        // Level and Topic of the Chain currently built on this Thread. Thread-Local so a Chain
+        // on one Thread (or the Writer-Thread of a BAsyncDecorator) can't be reset by another Thread
         static BLogLevel& currentLogLevel() {
-            static BLogLevel currentLogLevel = BLogLevel::NONE;
+            static thread_local BLogLevel currentLogLevel = defaultLogLevel();
             return currentLogLevel;
         }
 
@@ -42,7 +62,7 @@ struct BLogger {
         }
 
         static std::string& currentTopic() {
-            static std::string currentTopic = "";
+            static thread_local std::string currentTopic = defaultTopic();
             return currentTopic;
         }
 
@@ -51,19 +71,71 @@ struct BLogger {
             return defaultTopic;
         }
 
+        // Level configured for the Logger the current Record came in through (the one the Chain was
+        // started on). Loggers that capture below the Threshold filter against this one
+        static BLogLevel& recordThreshold() {
+            static thread_local BLogLevel recordThreshold = BLogLevel::NONE;
+            return recordThreshold;
+        }
+
         static bool& condition() {
             static thread_local bool condition = true;
             return condition;
         }
+
+        // Scratch Buffer for serializing BLogMessages. Keeps its capacity, so after the first
+        // few Logs serializing a Message does not allocate anymore
+        static std::string& serializeBuffer() {
+            static thread_local std::string serializeBuffer;
+            return serializeBuffer;
+        }
                                                       
         // Log last logged Message without decorations. Thread-Local should be sufficient 
         // as thats what we expect anyway most of the Time. 
         static thread_local std::string lastMessage;
 
-        static std::atomic<ID> instance_counter;
+        // Own Cache-Line, so creating Loggers does not invalidate hot Data next to it
+        static BLogCacheLine<std::atomic<ID>> instance_counter;
 
         virtual void log(const std::string&) = 0;
 
+        // Payload-Fragment of a Chain, never the End of the Record - even if it is just "\n".
+        // Default hands it to log() like before, Loggers that must not mistake a Payload of "\n"
+        // for the End of the Record (every BLoggerDecorator) override this
+        virtual void logFragment(const std::string& fragment) {
+            log(fragment);
+        }
+
+        // A finished Record as Segments. Default joins them and goes through log() like before,
+        // Sinks that can write the Segments directly (e.g. BFdLogger via writev) override this
+        virtual void logSegments(BLogSegments& segments) {
+            static thread_local std::string joined;
+            joined.clear();
+            for(const auto& segment : segments)
+                joined += segment;
+            if(!joined.empty())
+                log(joined);
+            log("\n");
+        }
+
+        // Write out whatever the Logger still buffers. Called by flush() under the Chain-Mutex
+        virtual void flushOutput() { }
+
+        // Wait until Records queued for other Threads (e.g. BAsyncDecorator) have reached the Loggers below.
+        // Called by flush() before flushOutput() and without the Chain-Mutex, those Threads need it to write
+        virtual void drainPending() { }
+
+        // Loggers that want to see Records below the configured Level (e.g. to keep them in a
+        // Backtrace) return true here. They then have to do the Level-Filtering themselves (see recordThreshold)
+        virtual bool capturesBelowThreshold() const {
+            return false;
+        }
+
+        // The Mutex every Chain holds, for Loggers that write from a Thread of their own (e.g. a Timer)
+        static std::mutex& chainMutex() {
+            return outputMutex();
+        }
+
     private:
         static std::mutex& outputMutex() {
             static std::mutex outputMutex;
@@ -76,10 +148,7 @@ struct BLogger {
         }
 
         inline bool shouldLog(BLogLevel messageLevel, const std::string& messageTopic) {
-            if(!messageTopic.empty() && !BLoggerConfig::isTopicEnabled(messageTopic))
-                return false;
-
-            return messageLevel >= BLoggerConfig::getLoggerLevel(name);
+            return isEnabled(messageLevel, messageTopic);
         }
 
         class Chain {
@@ -91,10 +160,13 @@ struct BLogger {
             public:
                 // Initial Message only relevant on first call -> Passing responsibility of Logging 
                 // to Chain. Chain starts Lock and then performs Operations. After last Chain it
-                // destructs and releases Lock
-                Chain(BLogger& l, const std::string& initialMsg = "") : logger(l), lock(outputMutex()), doLog(l.shouldLog(currentLogLevel(), BLogger::currentTopic()) && condition()) {
-                    if(doLog)
-                        *this << initialMsg;        // Process the Initial Message under the Lock
+                // destructs and releases Lock. The Initial Message is only converted if it is actually logged
+                template<typename T>
+                Chain(BLogger& l, const T& initialMsg) : logger(l), lock(outputMutex()), doLog(l.shouldLog(currentLogLevel(), BLogger::currentTopic()) && condition()) {
+                    if(doLog) {
+                        recordThreshold() = BLoggerConfig::getLoggerLevel(l.name);
+                        *this << initialMsg;
+                    }        // Process the Initial Message under the Lock
                 }
 
                 Chain(Chain&& other) noexcept : logger(other.logger), lock(std::move(other.lock)) { }
@@ -119,9 +191,12 @@ struct BLogger {
                 typename std::enable_if<std::is_base_of<BLogMessage, T>::value, Chain&>::type
                 operator<<(const T& msg) {
                     if(doLog) {
-                        std::string strMsg = msg.serialize();
-                        logger.log(strMsg);
-                        lastMessage += strMsg;
+                        std::string& buffer = serializeBuffer();
+                        buffer.clear();
+                        buffer.reserve(msg.sizeHint());
+                        msg.serializeTo(buffer);
+                        logger.logFragment(buffer);
+                        lastMessage += buffer;
                     }
                     return *this;
                 }
@@ -130,12 +205,24 @@ struct BLogger {
                 template<typename T>
                 typename std::enable_if<!std::is_base_of<BLogMessage, T>::value, Chain&>::type
                 operator<<(const T& value) {
-                    if(doLog) {
+                    if(!doLog)
+                        return *this;
+
+                    // Strings need no Stream, the Buffer keeps its Capacity
+                    if constexpr(std::is_same<T, std::string>::value) {
+                        logger.logFragment(value);
+                        lastMessage += value;
+                    } else if constexpr(std::is_convertible<const T&, std::string_view>::value) {
+                        std::string& buffer = serializeBuffer();
+                        buffer.assign(std::string_view(value));
+                        logger.logFragment(buffer);
+                        lastMessage += buffer;
+                    } else {
                         std::ostringstream ss;
                         ss << value;
 
                         std::string strMsg = ss.str();
-                        logger.log(strMsg);
+                        logger.logFragment(strMsg);
                         lastMessage += strMsg;
                     }
                     return *this;
@@ -192,6 +279,64 @@ struct BLogger {
             return this->currentTopic();
         }
 
+        // Push out everything still buffered somewhere in this Logger (and the Loggers it wraps).
+        // Must not be called inside of a running Chain
+        void flush() {
+            drainPending();
+            std::lock_guard<std::mutex> lock(outputMutex());
+            flushOutput();
+        }
+
+        // Would a Message with this Level and Topic pass the Filters of BLoggerConfig
+        // (or be captured by a Logger down the Chain, see capturesBelowThreshold)?
+        inline bool isEnabled(BLogLevel messageLevel, std::string_view messageTopic) const {
+            return isEnabled(messageLevel, messageTopic, BLoggerConfig::getLoggerLevel(name));
+        }
+
+        // Same with the configured Level of this Logger already looked up, for Callers that need it afterwards
+        inline bool isEnabled(BLogLevel messageLevel, std::string_view messageTopic, BLogLevel threshold) const {
+            if(!messageTopic.empty() && !BLoggerConfig::isTopicEnabled(messageTopic))
+                return false;
+
+            return messageLevel >= threshold || capturesBelowThreshold();
+        }
+
+        // Would a Chain started right now on this Thread be logged (current Level, Topic and Condition)?
+        inline bool wouldLog() const {
+            return condition() && isEnabled(currentLogLevel(), currentTopic());
+        }
+
+        // Counterpart for a Record that wouldLog() turned away: resets Level, Topic and Condition like
+        // the End of a Chain, without taking the Lock for a Chain that writes nothing
+        inline void skipRecord() const {
+            currentTopic() = defaultTopic();
+            currentLogLevel() = defaultLogLevel();
+            condition() = true;
+        }
+
+        // Log one finished Record in a single Call. Level and Topic are passed explicitly instead of
+        // going through the per Thread State of the Chain, so the Record can be built anywhere
+        // (another Thread, a Task, a Coroutine Frame) and handed in at once.
+        // Level and Topic are only set for the Duration of the Call so Decorators (e.g. BLoglevelDecorator) see them
+        void logRecord(BLogLevel level, const std::string& topic, const std::string& record) {
+            std::lock_guard<std::mutex> lock(outputMutex());
+            if(!isEnabled(level, topic))
+                return;
+
+            BLogLevel previousLevel = currentLogLevel();
+            std::string previousTopic = std::move(currentTopic());
+            currentLogLevel() = level;
+            currentTopic() = topic;
+            recordThreshold() = BLoggerConfig::getLoggerLevel(name);
+
+            if(!record.empty())
+                logFragment(record);
+            log("\n");
+
+            currentLogLevel() = previousLevel;
+            currentTopic() = std::move(previousTopic);
+        }
+
         // Log level via []
         virtual BLogger& operator[](BLogLevel level) {
             currentLogLevel() = level;
@@ -225,8 +370,8 @@ struct BLogger {
             // We enter this Function every FIRST Entry of a Log. Therefore we can reset the old "LastMsg"
             lastMessage = "";
 
-            std::string strMsg = msg.serialize();
-            return Chain(*this, strMsg);
+            // Serialization happens inside the Chain, so filtered Messages are never serialized
+            return Chain(*this, static_cast<const BLogMessage&>(msg));
         }
 
         // For Types that DON'T have an Implementation of the custom BLogMessage-Interface,
@@ -243,12 +388,8 @@ struct BLogger {
             // We enter this Function every FIRST Entry of a Log. Therefore we can reset the old "LastMsg"
             lastMessage = "";
 
-            // Convert any regular Datatype to String
-            std::ostringstream ss;
-            ss << value;
-
-            std::string strMsg = ss.str();
-            return Chain(*this, strMsg);
+            // Conversion happens inside the Chain as well, filtered Values are never converted
+            return Chain(*this, value);
         }
         
         // Conditional Logging for single Bool
@@ -309,7 +450,8 @@ struct BLogger {
 
 };
 
-inline std::atomic<uint8_t> BLogger::instance_counter = 0;
+inline BLogCacheLine<std::atomic<BLogger::ID>> BLogger::instance_counter{{0}};
+static_assert(sizeof(BLogCacheLine<std::atomic<BLogger::ID>>) == 64, "Counter has to fill its Cache-Line");
 inline thread_local std::string BLogger::lastMessage = "";
 
 #endif
@@ -5,6 +5,7 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 enum class BLogLevel {
     NONE,
@@ -38,8 +39,9 @@ class BLoggerConfig {
         }
 
         // Empty means all topics
-        static inline std::set<std::string>& enabledTopics() {
-            static std::set<std::string> instance;
+        // Transparent Comparator, so a Topic can be looked up without building a std::string
+        static inline std::set<std::string, std::less<>>& enabledTopics() {
+            static std::set<std::string, std::less<>> instance;
             return instance;
         };              
 
@@ -85,7 +87,7 @@ class BLoggerConfig {
             return (it != levels.end()) ? it->second : defaultLogLevel();
         }
 
-        static bool isTopicEnabled(const std::string& topic) noexcept {
+        static bool isTopicEnabled(std::string_view topic) noexcept {
             return enabledTopics().empty() || enabledTopics().find(topic) != enabledTopics().end();
         }
 
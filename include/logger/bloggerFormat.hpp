@@ -0,0 +1,254 @@
+#ifndef BLOGGER_FORMAT_HPP
+#define BLOGGER_FORMAT_HPP
+
+#include <charconv>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "blogger.hpp"
+#include "bloggerMessage.hpp"
+
+// Log with a Format-String that is parsed and checked at Compiletime:
+//
+// BLOGF((*lg)[BLogLevel::INFO], "x={} y={}", x, y);
+// BLOGF(context.warning(), "took {:f}ms, {:d} retries, flags {:x}", ms, retries, flags);
+//
+// Placeholders:
+//  - {}    any Value the Chain could log as well (BLogMessages, Strings, Numbers, everything with an operator<<)
+//  - {:d}  Integers in decimal
+//  - {:x}  Integers in lowercase hex (without Prefix)
+//  - {:f}  Floats in fixed Notation
+//  - {:s}  Strings
+// {{ and }} are a literal Brace.
+// A broken Format, a wrong Number of Arguments or an Argument that does not fit its Placeholder is a
+// Compile-Error. The Arguments are only formatted if the Record is actually logged
+#define BLOGF(logger, format, ...) \
+    BLogFormat::log([]() { \
+        struct BLogFormatString { \
+            static constexpr std::string_view str() { return format; } \
+        }; \
+        return BLogFormatString(); \
+    }(), logger, ##__VA_ARGS__)
+
+class BLogFormat {
+    public:
+        enum class Error {
+            NONE,
+            UNMATCHED_OPEN,             // '{' without a closing '}'
+            UNMATCHED_CLOSE,            // '}' that is neither "}}" nor closes a Placeholder
+            UNKNOWN_SPEC                // Something else than {}, {:d}, {:x}, {:f} or {:s}
+        };
+
+        // One Placeholder and the Literal in front of it (Offsets into the Format-String)
+        struct Slot {
+            size_t literalBegin;
+            size_t literalEnd;
+            char spec;                  // 0 for {}, otherwise the Character after the ':'
+        };
+
+        // All Placeholders of a Format. The Slot behind the last Placeholder only holds the trailing Literal
+        template<size_t N>
+        struct Layout {
+            Slot slots[N + 1];
+            bool escapes;               // Literal contains {{ or }}, has to be unescaped while appending
+        };
+
+    private:
+        // Walks the Format once, calls onSlot for every Placeholder. Shared by all constexpr Passes
+        template<typename OnSlot>
+        static constexpr Error walk(std::string_view fmt, OnSlot&& onSlot, bool& escapes) {
+            size_t literalBegin = 0;
+            size_t i = 0;
+            while(i < fmt.size()) {
+                if(fmt[i] == '{') {
+                    if(i + 1 < fmt.size() && fmt[i + 1] == '{') {
+                        escapes = true;
+                        i += 2;
+                        continue;
+                    }
+                    size_t close = fmt.find('}', i);
+                    if(close == std::string_view::npos)
+                        return Error::UNMATCHED_OPEN;
+
+                    char spec = 0;
+                    if(close == i + 3 && fmt[i + 1] == ':')
+                        spec = fmt[i + 2];
+                    else if(close != i + 1)
+                        return Error::UNKNOWN_SPEC;
+                    if(spec != 0 && spec != 'd' && spec != 'x' && spec != 'f' && spec != 's')
+                        return Error::UNKNOWN_SPEC;
+
+                    onSlot(Slot{literalBegin, i, spec});
+                    i = close + 1;
+                    literalBegin = i;
+                } else if(fmt[i] == '}') {
+                    if(i + 1 < fmt.size() && fmt[i + 1] == '}') {
+                        escapes = true;
+                        i += 2;
+                        continue;
+                    }
+                    return Error::UNMATCHED_CLOSE;
+                } else {
+                    i++;
+                }
+            }
+            onSlot(Slot{literalBegin, fmt.size(), 0});
+            return Error::NONE;
+        }
+
+        template<typename Fmt>
+        struct Parsed {
+            static constexpr std::string_view fmt = Fmt::str();
+
+            static constexpr Error error() {
+                bool escapes = false;
+                return walk(fmt, [](const Slot&) {}, escapes);
+            }
+
+            static constexpr size_t count() {
+                bool escapes = false;
+                size_t slots = 0;
+                walk(fmt, [&slots](const Slot&) { slots++; }, escapes);
+                return slots - 1;               // Trailing Literal is no Placeholder
+            }
+
+            static constexpr Layout<count()> layout() {
+                Layout<count()> result{};
+                size_t next = 0;
+                walk(fmt, [&result, &next](const Slot& slot) { result.slots[next++] = slot; }, result.escapes);
+                return result;
+            }
+
+            static constexpr Layout<count()> value = layout();
+        };
+
+        static std::string& buffer() {
+            static thread_local std::string buffer;
+            return buffer;
+        }
+
+        template<typename Fmt, size_t I>
+        static void appendLiteral(std::string& out) {
+            constexpr Slot slot = Parsed<Fmt>::value.slots[I];
+            constexpr std::string_view literal = Parsed<Fmt>::fmt.substr(slot.literalBegin, slot.literalEnd - slot.literalBegin);
+            if constexpr(literal.empty()) {
+                return;
+            } else if constexpr(!Parsed<Fmt>::value.escapes) {
+                out.append(literal.data(), literal.size());
+            } else {
+                // Both Escapes are doubled Characters, so keeping every second one is enough
+                for(size_t i = 0; i < literal.size(); i++) {
+                    out += literal[i];
+                    if((literal[i] == '{' || literal[i] == '}') && i + 1 < literal.size() && literal[i + 1] == literal[i])
+                        i++;
+                }
+            }
+        }
+
+        template<typename T>
+        static void appendInteger(std::string& out, T value, int base) {
+            char digits[72];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value, base);
+            out.append(digits, result.ptr);
+        }
+
+        template<typename T>
+        static void appendFloat(std::string& out, T value, const char* spec) {
+            char digits[64];
+            int length = std::snprintf(digits, sizeof(digits), spec, static_cast<double>(value));
+            if(length < 0)
+                return;
+            if(static_cast<size_t>(length) < sizeof(digits)) {
+                out.append(digits, static_cast<size_t>(length));
+            } else {
+                // Huge Values in fixed Notation
+                size_t offset = out.size();
+                out.resize(offset + static_cast<size_t>(length) + 1);
+                std::snprintf(&out[offset], static_cast<size_t>(length) + 1, spec, static_cast<double>(value));
+                out.resize(offset + static_cast<size_t>(length));
+            }
+        }
+
+        template<char Spec, typename T>
+        static void appendArgument(std::string& out, const T& value) {
+            constexpr bool isString = std::is_convertible<const T&, std::string_view>::value;
+            // A Stream prints all three Char-Types as Character, {:d}/{:x} still take signed/unsigned char as Number
+            constexpr bool isChar = std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value;
+            constexpr bool isInteger = std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value;
+
+            if constexpr(Spec == 'd' || Spec == 'x') {
+                static_assert(isInteger, "BLOGF: {:d} and {:x} need an Integer Argument");
+                if constexpr(Spec == 'x')
+                    appendInteger(out, static_cast<std::make_unsigned_t<T>>(value), 16);
+                else
+                    appendInteger(out, value, 10);
+            } else if constexpr(Spec == 'f') {
+                static_assert(std::is_floating_point<T>::value, "BLOGF: {:f} needs a Floating-Point Argument");
+                appendFloat(out, value, "%f");
+            } else if constexpr(Spec == 's') {
+                static_assert(isString, "BLOGF: {:s} needs a String Argument");
+                out += std::string_view(value);
+            } else if constexpr(std::is_base_of<BLogMessage, T>::value) {
+                value.serializeTo(out);
+            } else if constexpr(isString) {
+                out += std::string_view(value);
+            } else if constexpr(std::is_same<T, bool>::value) {
+                out += value ? '1' : '0';       // Same as the Chain
+            } else if constexpr(isChar) {
+                out += static_cast<char>(value);    // Same as the Chain
+            } else if constexpr(isInteger) {
+                appendInteger(out, value, 10);
+            } else if constexpr(std::is_floating_point<T>::value) {
+                appendFloat(out, value, "%g");  // Same as the default of a Stream
+            } else {
+                std::ostringstream ss;
+                ss << value;
+                out += ss.str();
+            }
+        }
+
+        template<typename Fmt, typename... Args, size_t... I>
+        static void formatAll(std::string& out, std::index_sequence<I...>, const Args&... args) {
+            ((appendLiteral<Fmt, I>(out), appendArgument<Parsed<Fmt>::value.slots[I].spec>(out, args)), ...);
+            appendLiteral<Fmt, sizeof...(Args)>(out);
+        }
+
+    public:
+        // Append the formatted Record to out. Fmt is a Type with a static constexpr str() (see BLOGF)
+        template<typename Fmt, typename... Args>
+        static void format(std::string& out, const Args&... args) {
+            static_assert(Parsed<Fmt>::error() != Error::UNMATCHED_OPEN, "BLOGF: '{' without a closing '}' (use {{ for a literal Brace)");
+            static_assert(Parsed<Fmt>::error() != Error::UNMATCHED_CLOSE, "BLOGF: '}' without an opening '{' (use }} for a literal Brace)");
+            static_assert(Parsed<Fmt>::error() != Error::UNKNOWN_SPEC, "BLOGF: only {}, {:d}, {:x}, {:f} and {:s} are supported");
+            if constexpr(Parsed<Fmt>::error() == Error::NONE) {
+                static_assert(Parsed<Fmt>::count() == sizeof...(Args), "BLOGF: Number of Arguments does not match the Placeholders");
+                if constexpr(Parsed<Fmt>::count() == sizeof...(Args))
+                    formatAll<Fmt>(out, std::index_sequence_for<Args...>{}, args...);
+            }
+        }
+
+        // Entry of BLOGF. Level, Topic and Condition are the ones already set on the Logger
+        template<typename Fmt, typename... Args>
+        static void log(Fmt, BLogger& logger, const Args&... args) {
+            if(!logger.wouldLog()) {
+                logger.skipRecord();
+                return;
+            }
+            std::string& out = buffer();
+            out.clear();
+            format<Fmt>(out, args...);
+            logger << out;
+        }
+
+        template<typename Fmt, typename L, typename... Args>
+        static void log(Fmt fmt, const std::shared_ptr<L>& logger, const Args&... args) {
+            log(fmt, static_cast<BLogger&>(*logger), args...);
+        }
+};
+
+#endif
@@ -1,12 +1,39 @@
 #ifndef BLOGGER_MESSAGE_HPP
 #define BLOGGER_MESSAGE_HPP
 
+#include <cstddef>
 #include <string>
 
 struct BLogMessage {
     public:
+        virtual ~BLogMessage() = default;
+
         virtual const std::string serialize() const = 0;
 
+        // Append the serialized Message to the Buffer of the caller (Chain reuses one per Thread).
+        // Default goes through serialize(), Messages derived from BLogBufferedMessage write directly
+        virtual void serializeTo(std::string& buffer) const {
+            buffer += serialize();
+        }
+
+        // Optional estimate of the serialized length so the Buffer can be grown once up front
+        virtual size_t sizeHint() const {
+            return 0;
+        }
+};
+
+// Base for Messages that write straight into the Buffer: serializeTo has to be implemented
+// (it is pure again), serialize() is derived from it for Callers that still want a String
+struct BLogBufferedMessage : public BLogMessage {
+    public:
+        void serializeTo(std::string& buffer) const override = 0;
+
+        const std::string serialize() const final {
+            std::string tmp;
+            tmp.reserve(sizeHint());
+            serializeTo(tmp);
+            return tmp;
+        }
 };
 
 #endif
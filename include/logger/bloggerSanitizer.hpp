@@ -0,0 +1,199 @@
+#ifndef BLOGGER_SANITIZER_HPP
+#define BLOGGER_SANITIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+struct BSanitizeOptions {
+    size_t maxLength = 0;                   // 0 means unlimited
+    std::string_view truncationMarker = "...";
+};
+
+// Makes untrusted Payloads safe for our line oriented Output:
+//  - Control Characters (incl. Newlines) and DEL are escaped ("\n", "\t", "\r", "\x1b", ...)
+//  - Backslashes are escaped as well, so the Escapes stay unambiguous
+//  - Invalid UTF-8 is replaced byte by byte with "\xHH", valid UTF-8 is kept as is
+//  - Optionally the Output is capped to maxLength Bytes (never splitting an Escape or UTF-8 Sequence)
+//
+// The Scan for "Bytes that need Attention" uses AVX2/SSE2 if the Compiler is allowed to use them
+// (-mavx2 / -march=native, SSE2 is always there on x86-64) and falls back to a plain Loop otherwise.
+// Clean Runs are then copied in one Piece, so mostly clean Text is basically a memcpy.
+class BLoggerSanitizer {
+    public:
+        using Options = BSanitizeOptions;
+
+        // Index of the first Byte that is not plain printable ASCII (or a Backslash); size if there is none
+        static size_t findUnsafe(const char* data, size_t size) {
+            size_t i = 0;
+            #if defined(__AVX2__)
+                const __m256i limit = _mm256_set1_epi8(0x20);
+                const __m256i del = _mm256_set1_epi8(0x7F);
+                const __m256i backslash = _mm256_set1_epi8('\\');
+                for(; i + 32 <= size; i += 32) {
+                    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                    // Signed compare: catches < 0x20 as well as >= 0x80 (negative) in one go
+                    __m256i bad = _mm256_or_si256(_mm256_cmpgt_epi8(limit, chunk),
+                                  _mm256_or_si256(_mm256_cmpeq_epi8(chunk, del), _mm256_cmpeq_epi8(chunk, backslash)));
+                    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(bad));
+                    if(mask)
+                        return i + __builtin_ctz(mask);
+                }
+            #endif
+            #if defined(__SSE2__)
+                const __m128i limit16 = _mm_set1_epi8(0x20);
+                const __m128i del16 = _mm_set1_epi8(0x7F);
+                const __m128i backslash16 = _mm_set1_epi8('\\');
+                for(; i + 16 <= size; i += 16) {
+                    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                    __m128i bad = _mm_or_si128(_mm_cmpgt_epi8(limit16, chunk),
+                                  _mm_or_si128(_mm_cmpeq_epi8(chunk, del16), _mm_cmpeq_epi8(chunk, backslash16)));
+                    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(bad));
+                    if(mask)
+                        return i + __builtin_ctz(mask);
+                }
+            #endif
+            return i + findUnsafeScalar(data + i, size - i);
+        }
+
+        // Plain Version, used for the Tail and on Platforms without SIMD
+        static size_t findUnsafeScalar(const char* data, size_t size) {
+            for(size_t i = 0; i < size; i++) {
+                if(isUnsafe(static_cast<unsigned char>(data[i])))
+                    return i;
+            }
+            return size;
+        }
+
+        static bool isClean(std::string_view in) {
+            return findUnsafe(in.data(), in.size()) == in.size();
+        }
+
+        // Appends the sanitized Version of in to out. With maxLength the Marker counts as well, room for
+        // it is kept while copying and only used if the Rest does not fit
+        static void sanitize(std::string_view in, std::string& out, const Options& options = Options()) {
+            const char* data = in.data();
+            const size_t size = in.size();
+            const size_t limit = options.maxLength;
+            const std::string_view marker = options.truncationMarker.substr(0, limit);
+            const size_t budget = limit - marker.size();            // Payload in front of the Marker
+            const size_t start = out.size();
+            size_t keep = start;                // End of the Output that still leaves room for the Marker
+            size_t written = 0;
+            size_t pos = 0;
+
+            out.reserve(out.size() + ((limit > 0 && limit < size) ? limit : size));
+
+            while(pos < size) {
+                // Copy the clean Run in one Piece
+                size_t run = findUnsafe(data + pos, size - pos);
+                if(limit > 0 && written + run > limit) {
+                    if(written < budget)
+                        out.append(data + pos, budget - written);
+                    else
+                        out.resize(keep);
+                    out += marker;
+                    return;
+                }
+                out.append(data + pos, run);
+                written += run;
+                pos += run;
+                if(written <= budget)
+                    keep = out.size();
+                else if(written - run < budget)
+                    keep = start + budget;          // Plain ASCII can be cut anywhere
+                if(pos >= size)
+                    break;
+
+                // Handle the single Byte (or UTF-8 Sequence) that stopped the Scan
+                char escape[4];
+                std::string_view piece;
+                unsigned char c = static_cast<unsigned char>(data[pos]);
+                size_t consumed = 1;
+
+                if(c >= 0x80) {
+                    size_t seq = utf8SequenceLength(data + pos, size - pos);
+                    if(seq > 0) {
+                        piece = std::string_view(data + pos, seq);
+                        consumed = seq;
+                    } else {
+                        piece = hexEscape(c, escape);
+                    }
+                } else {
+                    switch(c) {
+                        case '\n': piece = "\\n"; break;
+                        case '\r': piece = "\\r"; break;
+                        case '\t': piece = "\\t"; break;
+                        case '\\': piece = "\\\\"; break;
+                        default:   piece = hexEscape(c, escape); break;
+                    }
+                }
+
+                if(limit > 0 && written + piece.size() > limit) {
+                    out.resize(keep);
+                    out += marker;
+                    return;
+                }
+                out += piece;
+                written += piece.size();
+                pos += consumed;
+                if(written <= budget)
+                    keep = out.size();
+            }
+        }
+
+        static std::string sanitized(std::string_view in, const Options& options = Options()) {
+            std::string out;
+            sanitize(in, out, options);
+            return out;
+        }
+
+    private:
+        static inline bool isUnsafe(unsigned char c) {
+            return c < 0x20 || c >= 0x7F || c == '\\';
+        }
+
+        static std::string_view hexEscape(unsigned char c, char (&escape)[4]) {
+            static constexpr char HEX[] = "0123456789abcdef";
+            escape[0] = '\\';
+            escape[1] = 'x';
+            escape[2] = HEX[c >> 4];
+            escape[3] = HEX[c & 0xF];
+            return std::string_view(escape, 4);
+        }
+
+        // Length of the valid UTF-8 Sequence starting at data, 0 if it is invalid (overlong, surrogate, truncated...)
+        static size_t utf8SequenceLength(const char* data, size_t size) {
+            auto byte = [data](size_t i) { return static_cast<unsigned char>(data[i]); };
+            auto inRange = [](unsigned char c, unsigned char lo, unsigned char hi) { return c >= lo && c <= hi; };
+
+            unsigned char lead = byte(0);
+            size_t length;
+            unsigned char lo = 0x80, hi = 0xBF;     // Allowed Range of the first Continuation Byte
+
+            if(inRange(lead, 0xC2, 0xDF))       length = 2;
+            else if(lead == 0xE0)               { length = 3; lo = 0xA0; }
+            else if(inRange(lead, 0xE1, 0xEC))  length = 3;
+            else if(lead == 0xED)               { length = 3; hi = 0x9F; }
+            else if(inRange(lead, 0xEE, 0xEF))  length = 3;
+            else if(lead == 0xF0)               { length = 4; lo = 0x90; }
+            else if(inRange(lead, 0xF1, 0xF3))  length = 4;
+            else if(lead == 0xF4)               { length = 4; hi = 0x8F; }
+            else                                return 0;
+
+            if(size < length || !inRange(byte(1), lo, hi))
+                return 0;
+            for(size_t i = 2; i < length; i++) {
+                if(!inRange(byte(i), 0x80, 0xBF))
+                    return 0;
+            }
+            return length;
+        }
+};
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef BSHM_COLLECTOR_HPP
+#define BSHM_COLLECTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bshmRing.hpp"
+
+// Drains one or more BShmRings into a File that is rotated by Size:
+// path -> path.1 -> path.2 ... up to path.(maxFiles - 1), the oldest one is deleted.
+//
+// Either call drain()/drainFor() from an own Loop (e.g. in a dedicated Collector-Process) or let
+// start() run it on a Background-Thread. There must only be one Collector per Ring at a Time.
+// While idle the Collector sleeps on the Doorbell of the first Ring, further Rings are polled every
+// pollInterval, so one Ring per Collector gives the lowest Latency
+class BShmCollector {
+    private:
+        std::vector<std::unique_ptr<BShmRing>> rings;
+        const std::string path;
+        const size_t maxFileBytes;
+        const size_t maxFiles;
+        const std::chrono::milliseconds pollInterval;
+
+        int fd = -1;
+        size_t fileBytes = 0;
+        std::string batch;
+        std::string record;
+
+        std::atomic<bool> running{false};
+        std::thread worker;
+
+        inline void openFile() {
+            fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+            if(fd < 0)
+                throw std::runtime_error("Could not open log file: " + path + " (" + std::strerror(errno) + ")");
+            struct stat info;
+            fileBytes = ::fstat(fd, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+        }
+
+        inline void rotate() {
+            ::close(fd);
+            if(maxFiles <= 1) {
+                std::remove(path.c_str());
+            } else {
+                std::remove((path + "." + std::to_string(maxFiles - 1)).c_str());
+                for(size_t i = maxFiles - 1; i > 1; i--)
+                    std::rename((path + "." + std::to_string(i - 1)).c_str(), (path + "." + std::to_string(i)).c_str());
+                std::rename(path.c_str(), (path + ".1").c_str());
+            }
+            openFile();
+        }
+
+        inline void writeBatch() {
+            const char* data = batch.data();
+            size_t size = batch.size();
+            while(size > 0) {
+                ssize_t written = ::write(fd, data, size);
+                if(written < 0) {
+                    if(errno == EINTR)
+                        continue;
+                    break;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+            fileBytes += batch.size();
+            batch.clear();
+        }
+
+    public:
+        // maxFileBytes = 0 never rotates
+        inline BShmCollector(const std::vector<std::string>& ringNames, const std::string& filePath, size_t maxBytes = 64 * 1024 * 1024,
+                size_t keepFiles = 5, std::chrono::milliseconds poll = std::chrono::milliseconds(50))
+            : path(filePath), maxFileBytes(maxBytes), maxFiles(keepFiles), pollInterval(poll) {
+            if(ringNames.empty())
+                throw std::invalid_argument("Collector needs at least one ring");
+            for(const auto& ringName : ringNames)
+                rings.push_back(std::make_unique<BShmRing>(ringName));
+            openFile();
+        }
+
+        BShmCollector(const BShmCollector&) = delete;
+        BShmCollector& operator=(const BShmCollector&) = delete;
+
+        // Whatever is still in the Rings is written before the File is closed
+        inline ~BShmCollector() {
+            stop();
+            drain();
+            if(fd >= 0)
+                ::close(fd);
+        }
+
+        // Write everything that is in the Rings right now. Returns the Number of Records
+        inline size_t drain() {
+            size_t records = 0;
+            for(auto& ring : rings) {
+                while(true) {
+                    record.clear();
+                    if(!ring->consume(record))
+                        break;
+                    records++;
+                    // A Record is never split between two Files
+                    size_t pending = fileBytes + batch.size();
+                    if(maxFileBytes > 0 && pending > 0 && pending + record.size() + 1 > maxFileBytes) {
+                        writeBatch();
+                        rotate();
+                    }
+                    batch += record;
+                    batch += '\n';
+                    if(batch.size() >= 64 * 1024)
+                        writeBatch();
+                }
+            }
+            writeBatch();
+            return records;
+        }
+
+        // Sleep until something arrives (or the Timeout passes), then drain
+        inline size_t drainFor(std::chrono::milliseconds timeout) {
+            size_t records = drain();
+            if(records > 0)
+                return records;
+            rings.front()->waitForRecords(rings.size() > 1 ? std::min(timeout, pollInterval) : timeout);
+            return drain();
+        }
+
+        // Run the Collector on a Background-Thread until stop()
+        inline void start() {
+            if(running.exchange(true))
+                return;
+            worker = std::thread([this]() {
+                while(running.load(std::memory_order_relaxed))
+                    drainFor(pollInterval);
+            });
+        }
+
+        inline void stop() {
+            running.store(false);
+            if(worker.joinable())
+                worker.join();
+        }
+};
+
+#endif
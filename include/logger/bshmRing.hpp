@@ -0,0 +1,334 @@
+#ifndef BSHM_RING_HPP
+#define BSHM_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "blogger.hpp"
+#include "bloggerConfig.hpp"
+
+// Linux-only Ring of Records in POSIX Shared Memory (shm_open), shared by any Number of Processes.
+// Many Producers (BShmLogger), one Consumer (BShmCollector).
+//
+// The Ring is an Array of fixed Slots with a Sequence-Number each (bounded MPMC Queue after D. Vyukov):
+//  - a Producer claims k consecutive Slots with one CAS on head, copies the Record in and publishes the Slots
+//    (last to first, so once the first Slot is published, the whole Record is)
+//  - the Consumer reads the Record and hands the Slots back by bumping their Sequence one Lap ahead
+// Records longer than one Slot span several Slots, a Record is never split between Producers, so nothing
+// gets torn. Publishing is a CAS, a memcpy and a few Stores - no Syscall unless the Consumer sleeps.
+// The Consumer sleeps on a Futex (the Doorbell) in the shared Header, Producers only ring it if it does.
+//
+// A Producer that dies between claiming and publishing its Slots stalls the Ring, that is the Price of
+// having no Syscall and no Lock on the Way
+class BShmRing {
+    public:
+        static constexpr uint32_t MAGIC = 0x424c5352;           // "BLSR"
+        static constexpr uint32_t VERSION = 1;
+
+        enum class Overflow {
+            BLOCK,                  // Wait for the Consumer to make Room, at most blockTimeout, then drop (and count)
+            DROP                    // Drop the Record and count it (see dropped())
+        };
+
+    private:
+        struct Header {
+            std::atomic<uint32_t> magic;                        // Set last by the Creator, Openers wait for it
+            uint32_t version;
+            uint32_t slotCount;
+            uint32_t slotSize;
+
+            alignas(64) std::atomic<uint64_t> head;             // Next Position to claim, shared by the Producers
+            alignas(64) std::atomic<uint64_t> tail;             // Next Position to read, only the Consumer writes it
+            alignas(64) std::atomic<uint32_t> doorbell;         // Futex-Word, bumped to wake the Consumer
+            std::atomic<uint32_t> consumerSleeping;
+            std::atomic<uint64_t> dropped;
+        };
+
+        struct Slot {
+            std::atomic<uint64_t> sequence;
+            // Payload follows, slotSize - sizeof(Slot) Bytes
+        };
+
+        // In front of the Payload of the first Slot of every Record
+        struct RecordHeader {
+            uint32_t length;
+            uint32_t slots;
+            uint32_t level;
+            uint32_t reserved;
+        };
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared Memory needs address free Atomics");
+        static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared Memory needs address free Atomics");
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex needs a plain 32 Bit Word");
+
+        static constexpr size_t HEADER_BYTES = (sizeof(Header) + 63) / 64 * 64;
+
+        std::string name;
+        int fd = -1;
+        void* memory = MAP_FAILED;
+        size_t mappedBytes = 0;
+        Header* header = nullptr;
+        unsigned char* slots = nullptr;
+        uint64_t mask = 0;
+        size_t payloadBytes = 0;                                // Usable Bytes per Slot
+
+        inline Slot& slotAt(uint64_t position) const {
+            return *reinterpret_cast<Slot*>(slots + (position & mask) * header->slotSize);
+        }
+
+        inline unsigned char* payloadAt(uint64_t position) const {
+            return reinterpret_cast<unsigned char*>(&slotAt(position)) + sizeof(Slot);
+        }
+
+        inline static long futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout) {
+            // Not FUTEX_PRIVATE: the Word lives in Memory shared between Processes
+            return ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+        }
+
+        // Copy len Bytes into the Payloads starting at position, continuing in the following Slots
+        inline void copyIn(uint64_t position, size_t offset, const char* data, size_t length) {
+            while(length > 0) {
+                uint64_t at = position + offset / payloadBytes;
+                size_t inSlot = offset % payloadBytes;
+                size_t chunk = std::min(length, payloadBytes - inSlot);
+                std::memcpy(payloadAt(at) + inSlot, data, chunk);
+                data += chunk;
+                length -= chunk;
+                offset += chunk;
+            }
+        }
+
+        inline void copyOut(uint64_t position, size_t offset, char* out, size_t length) const {
+            while(length > 0) {
+                uint64_t at = position + offset / payloadBytes;
+                size_t inSlot = offset % payloadBytes;
+                size_t chunk = std::min(length, payloadBytes - inSlot);
+                std::memcpy(out, payloadAt(at) + inSlot, chunk);
+                out += chunk;
+                length -= chunk;
+                offset += chunk;
+            }
+        }
+
+        inline void map(size_t bytes) {
+            memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(memory == MAP_FAILED)
+                throw std::runtime_error("Could not map shared memory ring " + name + " (" + std::strerror(errno) + ")");
+            mappedBytes = bytes;
+            header = static_cast<Header*>(memory);
+        }
+
+        inline void initialize(uint32_t slotCount, uint32_t slotSize) {
+            if(::ftruncate(fd, static_cast<off_t>(HEADER_BYTES + size_t(slotCount) * slotSize)) != 0)
+                throw std::runtime_error("Could not size shared memory ring " + name + " (" + std::strerror(errno) + ")");
+            map(HEADER_BYTES + size_t(slotCount) * slotSize);
+
+            // Fresh Pages are zeroed, so only the non zero Parts need to be set
+            header->version = VERSION;
+            header->slotCount = slotCount;
+            header->slotSize = slotSize;
+            slots = static_cast<unsigned char*>(memory) + HEADER_BYTES;
+            mask = slotCount - 1;
+            for(uint64_t i = 0; i < slotCount; i++)
+                slotAt(i).sequence.store(i, std::memory_order_relaxed);
+            header->magic.store(MAGIC, std::memory_order_release);
+        }
+
+        // Another Process created it, wait until it is sized and initialized
+        inline void attach() {
+            struct stat info;
+            for(int attempt = 0; ; attempt++) {
+                if(::fstat(fd, &info) != 0)
+                    throw std::runtime_error("Could not stat shared memory ring " + name);
+                if(static_cast<size_t>(info.st_size) >= HEADER_BYTES)
+                    break;
+                if(attempt > 10000)
+                    throw std::runtime_error("Shared memory ring " + name + " was never initialized");
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            map(static_cast<size_t>(info.st_size));
+            for(int attempt = 0; header->magic.load(std::memory_order_acquire) != MAGIC; attempt++) {
+                if(attempt > 10000)
+                    throw std::runtime_error("Shared memory ring " + name + " was never initialized");
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            if(header->version != VERSION || mappedBytes < HEADER_BYTES + size_t(header->slotCount) * header->slotSize)
+                throw std::runtime_error("Shared memory ring " + name + " has an incompatible layout");
+            slots = static_cast<unsigned char*>(memory) + HEADER_BYTES;
+            mask = header->slotCount - 1;
+        }
+
+    public:
+        // Opens the Ring with this Name (e.g. "/myapp_log") or creates it with the given Geometry.
+        // slotCount has to be a Power of 2, slotSize a Multiple of 64. An existing Ring keeps its Geometry
+        inline BShmRing(const std::string& ringName, uint32_t slotCount = 4096, uint32_t slotSize = 256) : name(ringName) {
+            if(slotCount == 0 || (slotCount & (slotCount - 1)) != 0)
+                throw std::invalid_argument("Slot count has to be a power of 2");
+            if(slotSize < 64 || slotSize % 64 != 0)
+                throw std::invalid_argument("Slot size has to be a multiple of 64");
+
+            fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+            bool created = fd >= 0;
+            if(!created && errno == EEXIST)
+                fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0600);
+            if(fd < 0)
+                throw std::runtime_error("Could not open shared memory ring " + name + " (" + std::strerror(errno) + ")");
+
+            try {
+                if(created)
+                    initialize(slotCount, slotSize);
+                else
+                    attach();
+            } catch(...) {
+                if(memory != MAP_FAILED)
+                    ::munmap(memory, mappedBytes);
+                ::close(fd);
+                throw;
+            }
+            payloadBytes = header->slotSize - sizeof(Slot);
+        }
+
+        BShmRing(const BShmRing&) = delete;
+        BShmRing& operator=(const BShmRing&) = delete;
+
+        inline ~BShmRing() {
+            if(memory != MAP_FAILED)
+                ::munmap(memory, mappedBytes);
+            if(fd >= 0)
+                ::close(fd);
+        }
+
+        // Removes the Name, Processes that have it mapped keep using it
+        inline static void remove(const std::string& ringName) {
+            ::shm_unlink(ringName.c_str());
+        }
+
+        inline const std::string& getName() const {
+            return name;
+        }
+
+        // Longest Record that fits, longer ones are truncated
+        inline size_t maxRecordBytes() const {
+            return size_t(header->slotCount) * payloadBytes - sizeof(RecordHeader);
+        }
+
+        inline uint64_t dropped() const {
+            return header->dropped.load(std::memory_order_relaxed);
+        }
+
+        // Producer-Side, safe from any Number of Threads and Processes. The Caller usually holds the Chain-Mutex,
+        // so even BLOCK gives up after blockTimeout: a dead or missing Consumer must not hang all Logging
+        inline bool publish(const BLogSegments& record, BLogLevel level, Overflow overflow = Overflow::DROP,
+                std::chrono::milliseconds blockTimeout = std::chrono::seconds(1)) {
+            size_t length = 0;
+            for(const auto& segment : record)
+                length += segment.size();
+            length = std::min(length, maxRecordBytes());
+            uint64_t count = (sizeof(RecordHeader) + length + payloadBytes - 1) / payloadBytes;
+
+            // Claim count Slots. The Consumer frees Slots in Order, so if the last one is free all of them are
+            uint64_t position = header->head.load(std::memory_order_relaxed);
+            bool waiting = false;
+            std::chrono::steady_clock::time_point deadline;
+            while(true) {
+                uint64_t last = position + count - 1;
+                int64_t diff = static_cast<int64_t>(slotAt(last).sequence.load(std::memory_order_acquire) - last);
+                if(diff == 0) {
+                    if(header->head.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                        break;
+                } else if(diff < 0) {
+                    if(!waiting && overflow == Overflow::BLOCK) {
+                        waiting = true;
+                        deadline = std::chrono::steady_clock::now() + blockTimeout;
+                    }
+                    if(overflow == Overflow::DROP || std::chrono::steady_clock::now() >= deadline) {
+                        header->dropped.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    ::sched_yield();
+                    position = header->head.load(std::memory_order_relaxed);
+                } else {
+                    position = header->head.load(std::memory_order_relaxed);
+                }
+            }
+
+            RecordHeader recordHeader{static_cast<uint32_t>(length), static_cast<uint32_t>(count), static_cast<uint32_t>(level), 0};
+            copyIn(position, 0, reinterpret_cast<const char*>(&recordHeader), sizeof(recordHeader));
+            size_t offset = sizeof(RecordHeader);
+            size_t remaining = length;
+            for(const auto& segment : record) {
+                size_t chunk = std::min(segment.size(), remaining);
+                copyIn(position, offset, segment.data(), chunk);
+                offset += chunk;
+                remaining -= chunk;
+            }
+
+            for(uint64_t i = count; i-- > 0;)
+                slotAt(position + i).sequence.store(position + i + 1, std::memory_order_release);
+
+            // Pairs with the Fence in waitForRecords(): either we see the Consumer sleeping or it sees our Record
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(header->consumerSleeping.load(std::memory_order_relaxed)) {
+                header->doorbell.fetch_add(1, std::memory_order_release);
+                futex(&header->doorbell, FUTEX_WAKE, 1, nullptr);
+            }
+            return true;
+        }
+
+        // Consumer-Side, only one Consumer at a Time. Appends the Text of the next Record to out
+        inline bool consume(std::string& out, BLogLevel* level = nullptr) {
+            uint64_t position = header->tail.load(std::memory_order_relaxed);
+            if(slotAt(position).sequence.load(std::memory_order_acquire) != position + 1)
+                return false;
+
+            RecordHeader recordHeader;
+            copyOut(position, 0, reinterpret_cast<char*>(&recordHeader), sizeof(recordHeader));
+            size_t start = out.size();
+            out.resize(start + recordHeader.length);
+            copyOut(position, sizeof(RecordHeader), &out[start], recordHeader.length);
+            if(level)
+                *level = static_cast<BLogLevel>(recordHeader.level);
+
+            // Hand the Slots back, one Lap ahead
+            for(uint64_t i = 0; i < recordHeader.slots; i++)
+                slotAt(position + i).sequence.store(position + i + header->slotCount, std::memory_order_release);
+            header->tail.store(position + recordHeader.slots, std::memory_order_relaxed);
+            return true;
+        }
+
+        inline bool hasRecords() const {
+            uint64_t position = header->tail.load(std::memory_order_relaxed);
+            return slotAt(position).sequence.load(std::memory_order_acquire) == position + 1;
+        }
+
+        // Consumer-Side: sleep until a Record arrives or the Timeout passes
+        inline bool waitForRecords(std::chrono::milliseconds timeout) {
+            uint32_t bell = header->doorbell.load(std::memory_order_acquire);
+            header->consumerSleeping.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(!hasRecords()) {
+                timespec wait{static_cast<time_t>(timeout.count() / 1000), static_cast<long>(timeout.count() % 1000) * 1000000};
+                futex(&header->doorbell, FUTEX_WAIT, bell, &wait);
+            }
+            header->consumerSleeping.store(0, std::memory_order_relaxed);
+            return hasRecords();
+        }
+};
+
+#endif
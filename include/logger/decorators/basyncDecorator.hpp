@@ -0,0 +1,401 @@
+#ifndef BASYNC_DECORATOR_HPP
+#define BASYNC_DECORATOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bloggerDecorator.hpp"
+#include "../blogDeferredRecord.hpp"
+#include "../blogNuma.hpp"
+
+// Captures the raw Arguments of a Log-Statement and hands them to a BAsyncDecorator on Destruction.
+// Level and Topic come from the static Callsite, so they have to be Constants.
+//
+// BLOG_DEFERRED(asyncLogger, "network", BLogLevel::INFO) << "sent " << bytes << " bytes to " << host;
+#define BLOG_DEFERRED(logger, topic, level) \
+    BDeferredChain(BAsyncDecorator::from(logger), \
+        []() -> const BLogCallsite& { \
+            static const BLogCallsite blogCallsite{__FILE__, __LINE__, level, topic}; \
+            return blogCallsite; \
+        }())
+
+struct BAsyncOptions {
+    size_t writers = 1;                 // Writer-Threads, every one with its own Queue
+    std::vector<int> cpus;              // Pin Writer i to cpus[i], empty leaves them unpinned
+    size_t maxQueued = 0;               // Records per Queue, beyond that they are dropped (and counted). 0 is unbounded
+};
+
+// Moves Formatting, Decoration and Output of the wrapped Logger onto Background-Threads.
+//
+// Two Ways in:
+//  - The normal Chain (*lg << ...): Fragments are still formatted on the calling Thread, only the
+//    finished Record is queued. The Decorators below and the Sink run on a Writer-Thread
+//  - BLOG_DEFERRED: only the raw Arguments and a Pointer to the static Callsite are queued
+//    (see BDeferredRecord), the Writer-Thread does all of the Stringification as well
+//
+// Producers only take the short Queue-Lock to push. The Writer swaps the whole Queue out and
+// formats without any Lock, the wrapped Logger is then called under the usual Chain-Mutex (once per Record).
+// A Producer holding the Chain-Mutex must never wait for the Writer, so a full Queue (maxQueued) drops
+// the Record instead of blocking. Exceptions of the wrapped Logger are caught per Record and counted,
+// the Writer keeps running. flush() first waits for the Queues, then flushes the wrapped Logger
+//
+// With several Writers (BAsyncOptions) every Writer owns a Queue (Lane). A Writer that could be pinned puts
+// its Lane on the NUMA-Node of its CPU, and a Producer-Thread always uses a Lane of the Node it first logged
+// from (any Lane if its Node has no pinned Writer). Unpinned Lanes are shared round robin by all Producers.
+// Queue-Memory and the Arena the Deferred Records are formatted into are first touched by the Writer after
+// pinning, so they live on its Node. Records of one Thread keep their Order, between Threads (and Lanes)
+// there is no Order anymore.
+// What runs in parallel is the Formatting of Deferred Records. Decorators below and the Sink share their
+// State, so every Writer still calls them under the one Chain-Mutex, taken per Record. Record-Text of the Chain and Queue
+// Growth beyond the first Reservation are allocated by the Producer
+class BAsyncDecorator : public BLoggerDecorator {
+    private:
+        struct Item {
+            BLogLevel level;
+            BLogLevel threshold;                // Configured Level of the Logger the Record came in through
+            std::string topic;
+            std::string text;                   // Finished Record of the Chain
+            BDeferredRecord deferred;
+            size_t arenaBegin = 0;              // Output of the Formatting (Deferred) in the Arena of the Lane
+            size_t arenaEnd = 0;
+        };
+
+        // Touched by the Producers and the Writer, under the Mutex
+        struct LaneQueue {
+            std::mutex mutex;
+            std::condition_variable wakeWriter;
+            std::condition_variable drained;
+            std::vector<Item> pending;          // Filled by the Producers
+            uint64_t dropped = 0;
+            bool stop = false;
+            bool busy = false;
+            bool writerSleeping = false;
+            bool started = false;
+        };
+
+        // Only touched by the Writer (pinned and cpu are read once it has started)
+        struct LaneWriter {
+            std::vector<Item> writing;          // Swapped with pending
+            std::string arena;                  // Deferred Records of the current Batch are formatted into it
+            BLogSegments record;
+            bool pinned = false;
+            int cpu = -1;
+            std::thread thread;
+        };
+
+        // Lanes are used from different Sockets: both Parts on Cache-Lines of their own, so Producers pushing
+        // into one Lane neither disturb its Writer nor any other Lane
+        struct Lane {
+            BLogCacheLine<LaneQueue> queue;
+            BLogCacheLine<LaneWriter> writer;
+        };
+
+        std::vector<std::unique_ptr<Lane>> lanes;
+        size_t maxQueued = 0;
+        std::atomic<uint64_t> failed{0};        // Records the wrapped Logger threw on
+        std::vector<std::vector<Lane*>> lanesOfNode;    // Lanes of pinned Writers per Node, back() holds every Lane
+
+        // Lane of the calling Thread. The Node is looked up only once per Thread, so a Thread stays in its Lane
+        inline Lane& laneOfThread() {
+            if(lanes.size() == 1)
+                return *lanes.front();
+
+            static std::atomic<size_t> producerCounter{0};
+            static thread_local const size_t producer = producerCounter++;
+            if(lanesOfNode.size() == 1)
+                return *lanesOfNode.back()[producer % lanes.size()];
+
+            static thread_local const int node = BLogNuma::instance().currentNode();
+            const auto& local = node < static_cast<int>(lanesOfNode.size()) - 1 && !lanesOfNode[node].empty()
+                ? lanesOfNode[node] : lanesOfNode.back();
+            return *local[producer % local.size()];
+        }
+
+        inline void enqueue(Item&& item) {
+            LaneQueue& queue = *laneOfThread().queue;
+            bool wake;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if(maxQueued != 0 && queue.pending.size() >= maxQueued) {
+                    queue.dropped++;
+                    return;
+                }
+                queue.pending.push_back(std::move(item));
+                wake = queue.writerSleeping;
+            }
+            // Writer only needs a Notification if it actually sleeps, saves the Syscall while it is busy
+            if(wake)
+                queue.wakeWriter.notify_one();
+        }
+
+        void run(Lane& lane) {
+            LaneQueue& queue = *lane.queue;
+            LaneWriter& writer = *lane.writer;
+            std::unique_lock<std::mutex> lock(queue.mutex);
+
+            // Pin first, then allocate: Queue-Memory and Arena end up on the Node of the Writer
+            if(writer.cpu >= 0)
+                writer.pinned = BLogNuma::pinCurrent(writer.cpu);
+            queue.pending.reserve(1024);
+            writer.writing.reserve(1024);
+            writer.arena.reserve(64 * 1024);
+            queue.started = true;
+            queue.drained.notify_all();
+
+            while(true) {
+                queue.writerSleeping = true;
+                queue.wakeWriter.wait(lock, [&queue]() { return queue.stop || !queue.pending.empty(); });
+                queue.writerSleeping = false;
+                if(queue.pending.empty() && queue.stop)
+                    break;
+
+                std::swap(queue.pending, writer.writing);
+                queue.busy = true;
+                lock.unlock();
+
+                // Stringification without holding any Lock
+                writer.arena.clear();
+                for(auto& item : writer.writing) {
+                    if(const BLogCallsite* site = item.deferred.callsite()) {
+                        item.topic = site->topic;
+                        item.arenaBegin = writer.arena.size();
+                        item.deferred.format(writer.arena);
+                        item.arenaEnd = writer.arena.size();
+                    }
+                }
+                write(writer);
+                writer.writing.clear();
+
+                lock.lock();
+                queue.busy = false;
+                if(queue.pending.empty())
+                    queue.drained.notify_all();
+            }
+        }
+
+        // Decoration and Output, under the same Mutex the Chains use. Level and Topic are set per
+        // Record so Decorators below (e.g. BLoglevelDecorator) see the Values of the Record.
+        // The Mutex is taken per Record, so a Producer-Chain waits for one Record at most, not the whole Batch
+        inline void write(LaneWriter& writer) {
+            BLogLevel previousLevel = currentLogLevel();
+            std::string previousTopic = currentTopic();
+
+            for(auto& item : writer.writing) {
+                std::lock_guard<std::mutex> lock(chainMutex());
+                currentLogLevel() = item.level;
+                currentTopic() = item.topic;
+                recordThreshold() = item.threshold;
+                std::string_view text = item.deferred.callsite()
+                    ? std::string_view(writer.arena).substr(item.arenaBegin, item.arenaEnd - item.arenaBegin)
+                    : std::string_view(item.text);
+                try {
+                    if(text.empty()) {
+                        forward("\n");
+                    } else {
+                        writer.record.clear();
+                        writer.record.emplace_back(text);
+                        forwardSegments(writer.record);
+                    }
+                } catch(...) {
+                    failed++;
+                    // End the Record below anyway, so nothing of it sticks to the next one
+                    try {
+                        forward("\n");
+                    } catch(...) { }
+                }
+            }
+
+            currentLogLevel() = previousLevel;
+            currentTopic() = std::move(previousTopic);
+        }
+
+        inline void stopWriters() {
+            for(auto& lane : lanes) {
+                {
+                    std::lock_guard<std::mutex> lock(lane->queue->mutex);
+                    lane->queue->stop = true;
+                }
+                lane->queue->wakeWriter.notify_one();
+            }
+            for(auto& lane : lanes) {
+                if(lane->writer->thread.joinable())
+                    lane->writer->thread.join();
+            }
+        }
+
+    protected:
+        // Nothing added to the Message itself
+        inline std::string decorateMessage(const std::string& msg) override {
+            return msg;
+        }
+
+        // Record from a Decorator above, queued the same as one collected in log()
+        inline void logSegments(BLogSegments& incoming) override {
+            collectSegments(incoming);
+            log("\n");
+        }
+
+        // Called by the Chain on the Producer-Thread: collect the Fragments, queue the finished Record
+        inline void log(const std::string& msg) override {
+            if(msg != "\n") {
+                currentMessage += msg;
+                return;
+            }
+            enqueue(Item{getLogLevel(), recordThreshold(), getTopic(), std::move(currentMessage), BDeferredRecord()});
+            currentMessage.clear();
+        }
+
+        // flush() waits for the Queues first, so the wrapped Logger sees everything that was queued before
+        inline void drainPending() override {
+            waitForLanes();
+            BLoggerDecorator::drainPending();
+        }
+
+        inline void waitForLanes() {
+            for(auto& lane : lanes) {
+                LaneQueue& queue = *lane->queue;
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.drained.wait(lock, [&queue]() { return queue.pending.empty() && !queue.busy; });
+            }
+        }
+
+    public:
+        inline BAsyncDecorator(std::shared_ptr<BLogger> logger, const BAsyncOptions& options = BAsyncOptions())
+            : BLoggerDecorator(std::move(logger), "async"), maxQueued(options.maxQueued) {
+                if(!wrapped)
+                    throw std::invalid_argument("Logger cannot be null");
+                if(options.writers == 0)
+                    throw std::invalid_argument("At least one writer is needed");
+                if(!options.cpus.empty() && options.cpus.size() != options.writers)
+                    throw std::invalid_argument("Either no CPUs or one per writer have to be given");
+
+                for(size_t i = 0; i < options.writers; i++) {
+                    lanes.push_back(std::make_unique<Lane>());
+                    if(!options.cpus.empty())
+                        lanes.back()->writer->cpu = options.cpus[i];
+                }
+
+                for(auto& lane : lanes)
+                    lane->writer->thread = std::thread(&BAsyncDecorator::run, this, std::ref(*lane));
+                for(auto& lane : lanes) {
+                    LaneQueue& queue = *lane->queue;
+                    std::unique_lock<std::mutex> lock(queue.mutex);
+                    queue.drained.wait(lock, [&queue]() { return queue.started; });
+                }
+
+                // Only a pinned Writer belongs to a Node. One List per Node plus a last one with every Lane,
+                // for Producers on Nodes without a pinned Writer. Without any, that last List is all there is
+                const BLogNuma& numa = BLogNuma::instance();
+                for(auto& lane : lanes) {
+                    if(!lane->writer->pinned)
+                        continue;
+                    if(lanesOfNode.empty())
+                        lanesOfNode.resize(numa.nodeCount());
+                    lanesOfNode[numa.nodeOf(lane->writer->cpu)].push_back(lane.get());
+                }
+                lanesOfNode.emplace_back();
+                for(auto& lane : lanes)
+                    lanesOfNode.back().push_back(lane.get());
+            }
+
+        // Everything that was queued is still written before the Threads end
+        inline ~BAsyncDecorator() override {
+            stopWriters();
+        }
+
+        inline static std::shared_ptr<BAsyncDecorator> decorate(std::shared_ptr<BLogger> logger, const BAsyncOptions& options = BAsyncOptions()) {
+            if(logger == nullptr)
+                throw std::invalid_argument("Logger cannot be null");
+            return std::make_shared<BAsyncDecorator>(std::move(logger), options);
+        }
+
+        // Block until everything queued so far has been written by the wrapped Logger (same as flush()).
+        // Must not be called inside of a running Chain
+        inline void flushQueue() {
+            flush();
+        }
+
+        // Records dropped because their Queue was full (maxQueued)
+        inline uint64_t dropped() const {
+            uint64_t count = 0;
+            for(const auto& lane : lanes) {
+                std::lock_guard<std::mutex> lock(lane->queue->mutex);
+                count += lane->queue->dropped;
+            }
+            return count;
+        }
+
+        // Records the wrapped Logger threw an Exception on
+        inline uint64_t failedRecords() const {
+            return failed.load();
+        }
+
+        inline size_t writerCount() const {
+            return lanes.size();
+        }
+
+        // Writers that were actually pinned to their CPU (pinning a CPU outside of the allowed Set fails)
+        inline size_t pinnedWriters() const {
+            size_t pinned = 0;
+            for(const auto& lane : lanes)
+                pinned += lane->writer->pinned ? 1 : 0;
+            return pinned;
+        }
+
+        // Entry for BDeferredChain, the Record is already filtered against threshold
+        inline void enqueue(BDeferredRecord&& record, BLogLevel threshold) {
+            enqueue(Item{record.callsite()->level, threshold, std::string(), std::string(), std::move(record)});
+        }
+
+        // Unify the different Handles for BLOG_DEFERRED
+        static BAsyncDecorator& from(BAsyncDecorator& async) { return async; }
+        static BAsyncDecorator& from(const std::shared_ptr<BAsyncDecorator>& async) { return *async; }
+        static BAsyncDecorator& from(const std::shared_ptr<BLogger>& logger) {
+            auto* async = dynamic_cast<BAsyncDecorator*>(logger.get());
+            if(!async)
+                throw std::runtime_error("BLOG_DEFERRED needs a BAsyncDecorator as outermost Logger");
+            return *async;
+        }
+};
+
+// Collects the Arguments of one BLOG_DEFERRED Statement. Filtering happens once up front,
+// a disabled Statement does not even copy its Arguments
+class BDeferredChain {
+    private:
+        BAsyncDecorator* target = nullptr;
+        BDeferredRecord record;
+        BLogLevel threshold;
+
+    public:
+        BDeferredChain(BAsyncDecorator& async, const BLogCallsite& site)
+            : record(&site), threshold(BLoggerConfig::getLoggerLevel(async.getName())) {
+            if(async.isEnabled(site.level, site.topic, threshold))
+                target = &async;
+        }
+
+        BDeferredChain(const BDeferredChain&) = delete;
+        BDeferredChain& operator=(const BDeferredChain&) = delete;
+
+        ~BDeferredChain() {
+            if(target)
+                target->enqueue(std::move(record), threshold);
+        }
+
+        template<typename T>
+        BDeferredChain& operator<<(T&& value) {
+            if(target)
+                record.push(std::forward<T>(value));
+            return *this;
+        }
+};
+
+#endif
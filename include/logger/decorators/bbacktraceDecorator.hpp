@@ -0,0 +1,172 @@
+#ifndef BBACKTRACE_DECORATOR_HPP
+#define BBACKTRACE_DECORATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "bloggerDecorator.hpp"
+
+// Keeps the last N Records that are below the configured Level in a Ring instead of dropping them.
+// Once a Record at or above the Trigger-Level is written, the Ring is written out first (oldest first),
+// so an ERROR comes with the DEBUG-Context that led up to it - without writing DEBUG to Disk all the time.
+//
+// The configured Level is the one of the Logger the Record was logged through (usually the outermost one),
+// Records below it are stored - even at or above the Trigger-Level, they don't trigger a Dump then.
+// The Ring is kept per Topic or per Thread and allocated once, Slots keep their Capacity when reused.
+// At most maxRings Rings are kept, the one used least recently is dropped (with its Records) for a new one.
+// Decorators outside of this one have already formatted the stored Records (Timestamp at Log-Time),
+// Decorators inside format them when they are written out.
+class BBacktraceDecorator : public BLoggerDecorator {
+    public:
+        enum class Scope {
+            PER_TOPIC,
+            PER_THREAD
+        };
+
+    private:
+        struct Entry {
+            BLogLevel level;
+            std::string message;
+        };
+
+        struct Ring {
+            std::vector<Entry> entries;
+            size_t next = 0;            // Slot that gets overwritten next
+            size_t count = 0;
+            uint64_t lastUse = 0;
+
+            Ring(size_t capacity, size_t reserve) : entries(capacity) {
+                for(auto& entry : entries)
+                    entry.message.reserve(reserve);
+            }
+        };
+
+        const size_t capacity;
+        const BLogLevel triggerLevel;
+        const Scope scope;
+        const size_t maxRings;
+
+        // All Calls to log() happen under the outputMutex of the Chain, so no own Locking needed
+        std::unordered_map<std::string, Ring> topicRings;
+        std::unordered_map<std::thread::id, Ring> threadRings;
+        uint64_t uses = 0;
+
+        template<typename Map, typename Key>
+        inline Ring& ringFor(Map& rings, const Key& key) {
+            auto it = rings.find(key);
+            if(it == rings.end()) {
+                if(rings.size() >= maxRings) {
+                    auto oldest = rings.begin();
+                    for(auto candidate = rings.begin(); candidate != rings.end(); ++candidate) {
+                        if(candidate->second.lastUse < oldest->second.lastUse)
+                            oldest = candidate;
+                    }
+                    rings.erase(oldest);
+                }
+                it = rings.emplace(key, Ring(capacity, 128)).first;
+            }
+            it->second.lastUse = ++uses;
+            return it->second;
+        }
+
+        inline Ring& currentRing() {
+            if(scope == Scope::PER_THREAD)
+                return ringFor(threadRings, std::this_thread::get_id());
+            return ringFor(topicRings, getTopic());
+        }
+
+        inline void store(const std::string& msg, BLogLevel level) {
+            Ring& ring = currentRing();
+            Entry& entry = ring.entries[ring.next];
+            entry.level = level;
+            entry.message.assign(msg);
+            ring.next = (ring.next + 1) % capacity;
+            if(ring.count < capacity)
+                ring.count++;
+        }
+
+        // Write the stored Records out (oldest first) with their original Level, so inner Decorators show the right one
+        inline void dump(Ring& ring) {
+            if(ring.count == 0)
+                return;
+
+            BLogLevel triggeringLevel = currentLogLevel();
+            size_t start = (ring.next + capacity - ring.count) % capacity;
+            for(size_t i = 0; i < ring.count; i++) {
+                Entry& entry = ring.entries[(start + i) % capacity];
+                currentLogLevel() = entry.level;
+                forwardFragment(entry.message);
+                forward("\n");
+            }
+            currentLogLevel() = triggeringLevel;
+            ring.count = 0;
+            ring.next = 0;
+        }
+
+    protected:
+        // Nothing added to the Message itself
+        inline std::string decorateMessage(const std::string& msg) override {
+            return msg;
+        }
+
+        inline bool capturesBelowThreshold() const override {
+            return true;
+        }
+
+        // Record from a Decorator above, handled the same as one collected in log()
+        inline void logSegments(BLogSegments& incoming) override {
+            collectSegments(incoming);
+            log("\n");
+        }
+
+        inline void log(const std::string& msg) override {
+            if(msg != "\n") {
+                currentMessage += msg;
+                return;
+            }
+
+            BLogLevel level = getLogLevel();
+            if(level < recordThreshold()) {
+                if(!currentMessage.empty())
+                    store(currentMessage, level);
+                currentMessage.clear();
+                return;
+            }
+            if(level >= triggerLevel)
+                dump(currentRing());
+
+            if(!currentMessage.empty()) {
+                forwardFragment(currentMessage);
+                currentMessage.clear();
+            }
+            forward(msg);
+        }
+
+    public:
+        inline BBacktraceDecorator(std::shared_ptr<BLogger> logger, size_t ringSize = 64, BLogLevel trigger = BLogLevel::ERROR, Scope ringScope = Scope::PER_TOPIC,
+                size_t ringLimit = 64)
+            : BLoggerDecorator(std::move(logger), "backtrace"),
+            capacity(ringSize), triggerLevel(trigger), scope(ringScope), maxRings(ringLimit) {
+                if(!wrapped)
+                    throw std::invalid_argument("Logger cannot be null");
+                if(capacity == 0)
+                    throw std::invalid_argument("Backtrace needs at least one slot");
+                if(maxRings == 0)
+                    throw std::invalid_argument("Backtrace needs at least one ring");
+            }
+
+        inline static std::shared_ptr<BLogger> decorate(std::shared_ptr<BLogger> logger, size_t ringSize = 64, BLogLevel trigger = BLogLevel::ERROR, Scope ringScope = Scope::PER_TOPIC,
+                size_t ringLimit = 64) {
+            if(logger == nullptr)
+                throw std::invalid_argument("Logger cannot be null");
+            return std::make_shared<BBacktraceDecorator>(std::move(logger), ringSize, trigger, ringScope, ringLimit);
+        }
+};
+
+#endif
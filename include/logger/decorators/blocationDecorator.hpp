@@ -39,13 +39,23 @@ class BLocationDecorator : public BLoggerDecorator {
         static inline thread_local BLogger* lastLogger = nullptr;
 
     protected:
-        std::string decorateMessage(const std::string& msg) override {
+        bool decoratePrefix(std::string& prefix) override {
             std::lock_guard<std::mutex> lock(locationMutex);
             if(threadLocation.isValid) {
                 threadLocation.isValid = false;
-                return "[" + threadLocation.file + ":" + std::to_string(threadLocation.line) + "] " + msg;
+                prefix += "[";
+                prefix += threadLocation.file;
+                prefix += ":";
+                prefix += std::to_string(threadLocation.line);
+                prefix += "] ";
             }
-            return msg;
+            return true;
+        }
+
+        std::string decorateMessage(const std::string& msg) override {
+            std::string prefix;
+            decoratePrefix(prefix);
+            return prefix + msg;
         }
 
 
@@ -8,10 +8,19 @@ class BLoggerDecorator : public BLogger {
     protected:
         std::shared_ptr<BLogger> wrapped;
         std::string currentMessage;         // Accumulate Message until final "dispatch"
+        std::string prefix;                 // Our Prefix, referenced by the Segments while they are passed down
+        BLogSegments segments;              // Reused for every Record that starts here
 
         // Provide an interface to have an arbitrarily decorated Message (Front as well as Back) while collecting the logic here
         virtual std::string decorateMessage(const std::string& msg) = 0;
 
+        // Optional for Decorators that only put something in front of the Message: append the Prefix and
+        // return true. The Record is then passed down as Segments and never concatenated on the Way.
+        // Default false -> the full Message is joined and goes through decorateMessage
+        virtual bool decoratePrefix(std::string&) {
+            return false;
+        }
+
         // Try not to use .get() on instaces of our Decorator, but keep on using the shared_ptr
         // Otherwise the Object might be destroyed before use which leads to horrible stuff and hard errors
         inline BLoggerDecorator(std::shared_ptr<BLogger> logger, const std::string& decoratorType)
@@ -22,19 +31,80 @@ class BLoggerDecorator : public BLogger {
             }
         }
 
+        // Subclasses are no Friends of BLogger, so they have to go through here to reach the wrapped Logger
+        inline void forward(const std::string& msg) {
+            wrapped->log(msg);
+        }
+
+        // Payload that must not be taken for the End of the Record (see BLogger::logFragment)
+        inline void forwardFragment(const std::string& fragment) {
+            wrapped->logFragment(fragment);
+        }
+
+        inline void forwardSegments(BLogSegments& record) {
+            wrapped->logSegments(record);
+        }
+
+        // Somewhere down the Chain a Logger wants to see everything -> let it through up here as well
+        inline bool capturesBelowThreshold() const override {
+            return wrapped->capturesBelowThreshold();
+        }
+
+        // Join incoming Segments into currentMessage, for Decorators that work on the whole Record in log()
+        inline void collectSegments(const BLogSegments& incoming) {
+            for(const auto& segment : incoming)
+                currentMessage += segment;
+        }
+
+        // Payload is collected as it is, even a "\n" - no matter where in the Stack a Decorator sits
+        inline void logFragment(const std::string& fragment) override {
+            currentMessage += fragment;
+        }
+
         inline void log(const std::string& msg) override {
             // "Control Message" was sent -> If not empty clean up current message to be ready for next log
             if(msg == "\n") {
                 if(!currentMessage.empty()) {
-                    wrapped->log(decorateMessage(currentMessage));
+                    segments.clear();
+                    segments.emplace_back(currentMessage);
+                    logSegments(segments);
                     currentMessage.clear();
+                } else {
+                    wrapped->log(msg);
                 }
-                wrapped->log(msg);
             } else {
                 currentMessage += msg;
             }
         }
 
+        // Record coming from the Decorator above (or our own log()): put our Prefix in front and pass it on
+        inline void logSegments(BLogSegments& incoming) override {
+            prefix.clear();
+            if(decoratePrefix(prefix)) {
+                if(!prefix.empty())
+                    incoming.insert(incoming.begin(), std::string_view(prefix));
+                wrapped->logSegments(incoming);
+                return;
+            }
+
+            // Decorator needs the whole Message
+            std::string joined;
+            for(const auto& segment : incoming)
+                joined += segment;
+            std::string decorated = decorateMessage(joined);
+            incoming.clear();
+            incoming.emplace_back(decorated);
+            wrapped->logSegments(incoming);
+        }
+
+        inline void flushOutput() override {
+            wrapped->flushOutput();
+        }
+
+        inline void drainPending() override {
+            wrapped->drainPending();
+        }
+
     public:
         // In a Decorator we want to forward the GetLastMessage to the downmost 
         // Instance (the original Logger) to get the real Message
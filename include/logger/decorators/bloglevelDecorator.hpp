@@ -1,16 +1,32 @@
 #ifndef BLOGLEVEL_DECORATOR_HPP
 #define BLOGLEVEL_DECORATOR_HPP
 
+#include <string_view>
+
 #include "bloggerDecorator.hpp"
 
 class BLoglevelDecorator : public BLoggerDecorator {
     private:
+        // Prerendered per BLogLevel, saves the Map-Lookup in LEVEL_TO_STRING for every Record
+        static constexpr std::string_view LEVEL_TAGS[] = {
+            "[NONE] ",
+            "[DEBUG] ",
+            "[LOG] ",
+            "[INFO] ",
+            "[WARNING] ",
+            "[ERROR] "
+        };
 
     protected:
-        inline std::string decorateMessage(const std::string& msg) override {
-            std::string logLevel = LEVEL_TO_STRING.at(wrapped->getLogLevel());
+        inline bool decoratePrefix(std::string& prefix) override {
+            prefix += LEVEL_TAGS[static_cast<size_t>(wrapped->getLogLevel())];
+            return true;
+        }
 
-            return ("[" + logLevel + "] " + msg);
+        inline std::string decorateMessage(const std::string& msg) override {
+            std::string prefix;
+            decoratePrefix(prefix);
+            return prefix + msg;
         }
 
     public:
@@ -0,0 +1,243 @@
+#ifndef BREPEAT_DECORATOR_HPP
+#define BREPEAT_DECORATOR_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "bloggerDecorator.hpp"
+
+// Collapses repeated identical Records into one "last message repeated N times" Line, like syslog.
+//
+// Every Topic keeps its own last Record, so Repetitions of different Topics that are interleaved (a Retry-Loop
+// in "network" next to a Heartbeat in "health") are collapsed each on their own. Records are compared by a
+// 64 Bit Hash over Level and the Record itself, nothing is copied or compared character by character.
+// The first Record passes through, its Duplicates are only counted. The Summary of a Topic is written
+//  - right before the next different Record of that Topic
+//  - at the End of every Window of `timeout` (starting with the first Record or the last Summary) that
+//    counted Duplicates. While they keep coming the next Duplicate writes it, otherwise a Timer-Thread
+//    (started with the first Duplicate), so a Burst that just stops is not held back until the next Record
+//  - when the Topic is dropped to make room for a new one (at most maxTopics are tracked, the one seen
+//    longest ago goes first)
+//  - on flush() and Destruction
+// The Timer writes from its own Thread (under the Chain-Mutex), with Level and Topic of the repeated Record.
+// It can only be as exact as the Scheduler, so the Summary may come a bit later than the Window.
+// Within a Topic the Sink sees everything in the Order it was logged, the Summary of one Topic may come after
+// Records of other Topics that were logged in between.
+//
+// Place Decorators that make every Record unique (BTimestampDecorator) inside of this one. A BLocationDecorator
+// outside of it makes the Comparison per Call-Site
+class BRepeatDecorator : public BLoggerDecorator {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        const Clock::duration timeout;
+        const size_t maxTopics;
+
+        struct Repeat {
+            uint64_t hash = 0;
+            BLogLevel level = BLogLevel::NONE;
+            BLogLevel threshold = BLogLevel::NONE;
+            size_t repeats = 0;
+            Clock::time_point windowStart;
+            Clock::time_point lastSeen;
+        };
+
+        // Last Record per Topic
+        std::unordered_map<std::string, Repeat> lastPerTopic;
+
+        // Guarded by the Chain-Mutex like everything above
+        std::condition_variable wakeTimer;
+        bool stopTimer = false;
+        std::thread timer;
+
+        // FNV-1a
+        inline static void hashBytes(uint64_t& hash, const char* data, size_t size) {
+            for(size_t i = 0; i < size; i++) {
+                hash ^= static_cast<unsigned char>(data[i]);
+                hash *= 1099511628211ull;
+            }
+        }
+
+        // The Topic is the Key of lastPerTopic, no need to hash it as well
+        inline uint64_t hashRecord(const BLogSegments& record) const {
+            uint64_t hash = 14695981039346656037ull;
+            char level = static_cast<char>(getLogLevel());
+            hashBytes(hash, &level, 1);
+            for(const auto& segment : record)
+                hashBytes(hash, segment.data(), segment.size());
+            return hash;
+        }
+
+        // With Level and Topic of the repeated Record, so Decorators below format it like the Record itself
+        inline void writeSummary(const std::string& topic, Repeat& last) {
+            if(last.repeats == 0)
+                return;
+
+            BLogLevel previousLevel = currentLogLevel();
+            std::string previousTopic = currentTopic();
+            BLogLevel previousThreshold = recordThreshold();
+            currentLogLevel() = last.level;
+            currentTopic() = topic;
+            recordThreshold() = last.threshold;
+
+            forward("last message repeated " + std::to_string(last.repeats) + (last.repeats == 1 ? " time" : " times"));
+            forward("\n");
+
+            currentLogLevel() = previousLevel;
+            currentTopic() = std::move(previousTopic);
+            recordThreshold() = previousThreshold;
+            last.repeats = 0;
+        }
+
+        inline void writeAllSummaries() {
+            for(auto& [topic, last] : lastPerTopic)
+                writeSummary(topic, last);
+        }
+
+        // Makes room for a new Topic
+        inline void dropOldestTopic() {
+            auto oldest = lastPerTopic.begin();
+            for(auto it = lastPerTopic.begin(); it != lastPerTopic.end(); ++it) {
+                if(it->second.lastSeen < oldest->second.lastSeen)
+                    oldest = it;
+            }
+            writeSummary(oldest->first, oldest->second);
+            lastPerTopic.erase(oldest);
+        }
+
+        // Sleeps while nothing is counted, otherwise until the first Window with counted Duplicates is over
+        inline void runTimer() {
+            std::unique_lock<std::mutex> lock(chainMutex());
+            while(!stopTimer) {
+                bool counting = false;
+                Clock::time_point deadline = Clock::time_point::max();
+                for(const auto& entry : lastPerTopic) {
+                    if(entry.second.repeats == 0)
+                        continue;
+                    counting = true;
+                    if(entry.second.windowStart + timeout < deadline)
+                        deadline = entry.second.windowStart + timeout;
+                }
+                if(!counting) {
+                    wakeTimer.wait(lock);
+                    continue;
+                }
+                Clock::time_point now = Clock::now();
+                if(now < deadline) {
+                    wakeTimer.wait_until(lock, deadline);
+                    continue;                   // Windows may have moved in the Meantime
+                }
+                for(auto& [topic, last] : lastPerTopic) {
+                    if(last.repeats > 0 && now - last.windowStart >= timeout) {
+                        writeSummary(topic, last);
+                        last.windowStart = now;
+                    }
+                }
+            }
+        }
+
+        // Called with the Chain-Mutex held
+        inline void armTimer() {
+            if(!timer.joinable())
+                timer = std::thread([this]() { runTimer(); });
+            else
+                wakeTimer.notify_one();
+        }
+
+    protected:
+        // Nothing added to the Message itself
+        inline std::string decorateMessage(const std::string& msg) override {
+            return msg;
+        }
+
+        // Empty Records are compared as well, a Repetition ends on them too
+        inline void log(const std::string& msg) override {
+            if(msg != "\n") {
+                currentMessage += msg;
+                return;
+            }
+            segments.clear();
+            if(!currentMessage.empty())
+                segments.emplace_back(currentMessage);
+            logSegments(segments);
+            currentMessage.clear();
+        }
+
+        inline void logSegments(BLogSegments& incoming) override {
+            uint64_t hash = hashRecord(incoming);
+            Clock::time_point now = Clock::now();
+
+            auto it = lastPerTopic.find(getTopic());
+            if(it != lastPerTopic.end() && it->second.hash == hash) {
+                Repeat& last = it->second;
+                last.lastSeen = now;
+                last.repeats++;
+                if(now - last.windowStart >= timeout) {
+                    writeSummary(it->first, last);
+                    last.windowStart = now;
+                } else if(last.repeats == 1) {
+                    armTimer();
+                }
+                return;
+            }
+
+            if(it != lastPerTopic.end()) {
+                writeSummary(it->first, it->second);
+            } else {
+                if(lastPerTopic.size() >= maxTopics)
+                    dropOldestTopic();
+                it = lastPerTopic.emplace(getTopic(), Repeat()).first;
+            }
+            Repeat& last = it->second;
+            last.hash = hash;
+            last.level = getLogLevel();
+            last.threshold = recordThreshold();
+            last.windowStart = now;
+            last.lastSeen = now;
+            if(incoming.empty())
+                forward("\n");                 // Undecorated, like an empty Chain everywhere else
+            else
+                forwardSegments(incoming);
+        }
+
+        inline void flushOutput() override {
+            writeAllSummaries();
+            BLoggerDecorator::flushOutput();
+        }
+
+    public:
+        inline BRepeatDecorator(std::shared_ptr<BLogger> logger, std::chrono::milliseconds summaryTimeout = std::chrono::seconds(5), size_t topics = 64)
+            : BLoggerDecorator(std::move(logger), "repeat"), timeout(summaryTimeout), maxTopics(topics > 0 ? topics : 1) {
+                if(!wrapped)
+                    throw std::invalid_argument("Logger cannot be null");
+            }
+
+        // Repetitions counted so far are not lost
+        inline ~BRepeatDecorator() override {
+            {
+                std::lock_guard<std::mutex> lock(chainMutex());
+                stopTimer = true;
+            }
+            wakeTimer.notify_one();
+            if(timer.joinable())
+                timer.join();
+
+            std::lock_guard<std::mutex> lock(chainMutex());
+            writeAllSummaries();
+        }
+
+        inline static std::shared_ptr<BLogger> decorate(std::shared_ptr<BLogger> logger, std::chrono::milliseconds summaryTimeout = std::chrono::seconds(5), size_t topics = 64) {
+            if(logger == nullptr)
+                throw std::invalid_argument("Logger cannot be null");
+            return std::make_shared<BRepeatDecorator>(std::move(logger), summaryTimeout, topics);
+        }
+};
+
+#endif
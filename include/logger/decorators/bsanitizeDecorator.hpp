@@ -0,0 +1,44 @@
+#ifndef BSANITIZE_DECORATOR_HPP
+#define BSANITIZE_DECORATOR_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "bloggerDecorator.hpp"
+#include "../bloggerSanitizer.hpp"
+
+// Escapes Control Characters, invalid UTF-8 and caps the Length of the finished Record
+// (see BLoggerSanitizer). Decorators are applied from the outside in, so put it on the very
+// outside to only touch the Payload - the Prefixes of the Decorators inside stay untouched
+class BSanitizeDecorator : public BLoggerDecorator {
+    private:
+        BLoggerSanitizer::Options options;
+
+    protected:
+        inline std::string decorateMessage(const std::string& msg) override {
+            // Common Case: nothing to do
+            if(BLoggerSanitizer::isClean(msg) && (options.maxLength == 0 || msg.size() <= options.maxLength))
+                return msg;
+
+            std::string sanitized;
+            BLoggerSanitizer::sanitize(msg, sanitized, options);
+            return sanitized;
+        }
+
+    public:
+        inline BSanitizeDecorator(std::shared_ptr<BLogger> logger, BLoggerSanitizer::Options opts = BLoggerSanitizer::Options())
+            : BLoggerDecorator(std::move(logger), "sanitized"),
+            options(opts) {
+                if(!wrapped)
+                    throw std::invalid_argument("Logger cannot be null");
+            }
+
+        inline static std::shared_ptr<BLogger> decorate(std::shared_ptr<BLogger> logger, BLoggerSanitizer::Options opts = BLoggerSanitizer::Options()) {
+            if(logger == nullptr)
+                throw std::invalid_argument("Logger cannot be null");
+            return std::make_shared<BSanitizeDecorator>(std::move(logger), opts);
+        }
+};
+
+#endif
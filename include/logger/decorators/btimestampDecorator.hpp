@@ -26,6 +26,11 @@ class BTimestampDecorator : public BLoggerDecorator {
         };
 
     protected:
+        inline bool decoratePrefix(std::string& prefix) override {
+            prefix += getFTimeStamp();
+            return true;
+        }
+
         inline std::string decorateMessage(const std::string& msg) override {
             std::string timestamp = getFTimeStamp();
             return timestamp + msg;
@@ -0,0 +1,192 @@
+#ifndef BCOMPRESSED_FILE_LOGGER_HPP
+#define BCOMPRESSED_FILE_LOGGER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bfileLogger.hpp"
+#include "../blogCodec.hpp"
+
+struct BCompressOptions {
+    size_t blockBytes = 64 * 1024;                          // A Block is sealed once it is this big...
+    std::chrono::milliseconds window = std::chrono::seconds(1);  // ...or this old
+};
+
+// File-Sink writing compressed Frames (see BLogFrameHeader), read back with BLogFrameReader.
+//
+// Records are only appended to the current Block on the logging Thread. Full (or old enough) Blocks are
+// compressed and written on a Background-Thread, every Block as its own Frame with its own Checksum.
+// So after a Crash everything up to the last complete Frame can still be read.
+// Blocks that don't get smaller are stored uncompressed
+class BCompressedFileLogger : public BFileLogger {
+    private:
+        std::unique_ptr<BLogCodec> codec;
+        const BCompressOptions options;
+
+        std::string fragments;                  // Record of an undecorated Chain, only touched under the Chain-Mutex
+
+        std::mutex blockMutex;
+        std::condition_variable wakeWriter;
+        std::condition_variable drained;
+        std::string current;                    // Block the Records are appended to
+        std::chrono::steady_clock::time_point currentStart;
+        std::vector<std::string> sealed;        // Waiting for the Writer
+        std::vector<std::string> spare;         // Written Blocks, reused to keep their Capacity
+        bool stop = false;
+        bool busy = false;
+        std::thread writer;
+
+        std::string frame;                      // Only used by the Writer
+
+        // Hand the current Block to the Writer. blockMutex has to be held
+        inline void sealLocked() {
+            if(current.empty())
+                return;
+            sealed.push_back(std::move(current));
+            if(!spare.empty()) {
+                current = std::move(spare.back());
+                spare.pop_back();
+            } else {
+                current = std::string();
+                current.reserve(options.blockBytes + 256);
+            }
+            wakeWriter.notify_one();
+        }
+
+        // First Record of a Block starts its Window, the Writer needs to know about it
+        inline void startRecordLocked() {
+            if(current.empty()) {
+                currentStart = std::chrono::steady_clock::now();
+                wakeWriter.notify_one();
+            }
+        }
+
+        inline void endRecordLocked() {
+            current += '\n';
+            if(current.size() >= options.blockBytes)
+                sealLocked();
+        }
+
+        // A Block only grows beyond MAX_BLOCK_BYTES through a single huge Record, it is then split into several Frames
+        inline void writeBlock(const std::string& block) {
+            for(size_t offset = 0; offset < block.size(); offset += BLogFrameHeader::MAX_BLOCK_BYTES)
+                writeFrame(block.data() + offset, std::min<size_t>(block.size() - offset, BLogFrameHeader::MAX_BLOCK_BYTES));
+        }
+
+        inline void writeFrame(const char* data, size_t size) {
+            BLogFrameHeader header{BLogFrameHeader::MAGIC, codec->id(), {0, 0, 0}, static_cast<uint32_t>(size), 0,
+                BLogFrameHeader::checksumOf(data, size)};
+
+            frame.assign(sizeof(header), '\0');
+            codec->compress(data, size, frame);
+            if(frame.size() - sizeof(header) >= size) {
+                header.codec = BLogCodec::STORED;
+                frame.resize(sizeof(header));
+                frame.append(data, size);
+            }
+            header.compressedSize = static_cast<uint32_t>(frame.size() - sizeof(header));
+            std::memcpy(&frame[0], &header, sizeof(header));
+            writeFile(frame.data(), frame.size());
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(blockMutex);
+            while(true) {
+                if(sealed.empty()) {
+                    if(stop)
+                        break;
+                    if(current.empty()) {
+                        wakeWriter.wait(lock, [this]() { return stop || !sealed.empty() || !current.empty(); });
+                    } else if(!wakeWriter.wait_until(lock, currentStart + options.window, [this]() { return stop || !sealed.empty(); })) {
+                        sealLocked();           // Window is over
+                    }
+                    continue;
+                }
+
+                std::vector<std::string> writing;
+                writing.swap(sealed);
+                busy = true;
+                lock.unlock();
+
+                for(const auto& block : writing)
+                    writeBlock(block);
+
+                lock.lock();
+                busy = false;
+                for(auto& block : writing) {
+                    if(spare.size() >= 4)
+                        break;
+                    block.clear();
+                    spare.push_back(std::move(block));
+                }
+                if(sealed.empty())
+                    drained.notify_all();
+            }
+        }
+
+    protected:
+        inline void log(const std::string& message) override {
+            if(message != "\n") {
+                fragments += message;
+                return;
+            }
+            std::lock_guard<std::mutex> lock(blockMutex);
+            startRecordLocked();
+            current += fragments;
+            endRecordLocked();
+            fragments.clear();
+        }
+
+        inline void logSegments(BLogSegments& segments) override {
+            std::lock_guard<std::mutex> lock(blockMutex);
+            startRecordLocked();
+            for(const auto& segment : segments)
+                current += segment;
+            endRecordLocked();
+        }
+
+        // Seal the current Block and wait until everything is on Disk
+        inline void flushOutput() override {
+            std::unique_lock<std::mutex> lock(blockMutex);
+            sealLocked();
+            drained.wait(lock, [this]() { return sealed.empty() && !busy; });
+        }
+
+    public:
+        inline BCompressedFileLogger(const std::string& name, const std::string& filename,
+                const BCompressOptions& compressOptions = BCompressOptions(), std::unique_ptr<BLogCodec> blockCodec = BLogCodecs::preferred())
+            : BFileLogger(name, filename), codec(std::move(blockCodec)), options(compressOptions) {
+            if(!codec)
+                throw std::invalid_argument("Codec cannot be null");
+            if(options.blockBytes == 0)
+                throw std::invalid_argument("Block size has to be at least 1 byte");
+            current.reserve(options.blockBytes + 256);
+            writer = std::thread(&BCompressedFileLogger::run, this);
+        }
+
+        // Everything logged is written before the File is closed
+        inline ~BCompressedFileLogger() override {
+            {
+                std::lock_guard<std::mutex> lock(blockMutex);
+                sealLocked();
+                stop = true;
+            }
+            wakeWriter.notify_one();
+            if(writer.joinable())
+                writer.join();
+        }
+
+        inline const char* codecName() const {
+            return codec->name();
+        }
+};
+
+#endif
@@ -1,21 +1,204 @@
 #ifndef BCONSOLE_LOGGER_HPP
 #define BCONSOLE_LOGGER_HPP
 
-#include <iostream>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <unistd.h>
 
 #include "../blogger.hpp"
 
+enum class BConsoleColors {
+    AUTO,                       // Only if the Stream is a TTY (and NO_COLOR is not set)
+    ALWAYS,
+    NEVER
+};
+
+struct BConsoleOptions {
+    BConsoleColors colors = BConsoleColors::AUTO;
+    bool errorsToStderr = false;            // WARNING and above go to stderr, everything else to stdout
+    size_t batchBytes = 64 * 1024;          // Batch Size if the Stream is no TTY, 0 writes every Record right away
+    BLogLevel flushLevel = BLogLevel::ERROR;                        // Records at or above are written right away
+    std::chrono::milliseconds maxDelay = std::chrono::milliseconds(200);   // A Batch is written at the latest this long after it started
+    int outFd = STDOUT_FILENO;
+    int errFd = STDERR_FILENO;
+};
+
+// Writes straight to the Descriptors of stdout/stderr, no iostreams involved.
+//
+// On a TTY every Record is written as soon as it is finished (one write per Record, not per Fragment).
+// Otherwise (Pipe, File) Records are gathered and written once batchBytes are reached, maxDelay after the Batch
+// started or on flush()/Destruction. A Record at or above flushLevel is written right away (with everything batched
+// before it), so an ERROR reaches a Supervisor even if the Process dies right after. The maxDelay is kept by a
+// Timer-Thread (started with the first Batch, writing under the Chain-Mutex), so at most that much is lost on a Crash.
+// printf/std::cout Output is flushed before every Write, so it comes before the Records of that Write. Output
+// printed while Records are still batched overtakes them, set batchBytes to 0 if both are mixed on one Stream
+// With Colors every Record is wrapped in the ANSI-Color of its Level, the Sequences are prerendered per Level
 class BConsoleLogger : public BLogger {
+    private:
+        struct Stream {
+            int fd;
+            bool tty;
+            bool colored;
+            std::string buffer;
+            std::chrono::steady_clock::time_point batchStart;
+        };
+
+        // Indexed by BLogLevel
+        static constexpr std::string_view LEVEL_COLORS[] = {
+            "",                     // NONE
+            "\033[90m",             // DEBUG    grey
+            "",                     // LOG
+            "\033[32m",             // INFO     green
+            "\033[33m",             // WARNING  yellow
+            "\033[31m"              // ERROR    red
+        };
+        static constexpr std::string_view COLOR_RESET = "\033[0m";
+
+        BConsoleOptions options;
+        Stream out;
+        Stream err;
+
+        // Guarded by the Chain-Mutex like the Streams
+        std::condition_variable wakeTimer;
+        bool stopTimer = false;
+        std::thread timer;
+        std::string fragments;              // Fragments of an undecorated Chain (log() instead of logSegments())
+        BLogSegments ownSegments;
+
+        inline Stream openStream(int fd) const {
+            bool tty = ::isatty(fd) == 1;
+            bool colored = options.colors == BConsoleColors::ALWAYS
+                || (options.colors == BConsoleColors::AUTO && tty && std::getenv("NO_COLOR") == nullptr);
+            return Stream{fd, tty, colored, std::string(), {}};
+        }
+
+        inline static void writeAll(int fd, const char* data, size_t size) {
+            while(size > 0) {
+                ssize_t written = ::write(fd, data, size);
+                if(written < 0) {
+                    if(errno == EINTR)
+                        continue;
+                    return;                 // Nothing sensible left to do, a Logger must not throw mid Record
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+
+        inline void writeStream(Stream& stream) {
+            if(stream.buffer.empty())
+                return;
+            // Whatever went through printf/std::cout until now comes before this Write
+            if(stream.fd == STDOUT_FILENO)
+                std::fflush(stdout);
+            writeAll(stream.fd, stream.buffer.data(), stream.buffer.size());
+            stream.buffer.clear();
+        }
+
+        inline void writeRecord(const BLogSegments& record) {
+            BLogLevel level = getLogLevel();
+            bool toErr = options.errorsToStderr && level >= BLogLevel::WARNING;
+            Stream& stream = toErr ? err : out;
+
+            // Keep the Order between both Streams
+            writeStream(toErr ? out : err);
+
+            std::string_view color = stream.colored ? LEVEL_COLORS[static_cast<size_t>(level)] : std::string_view();
+            bool startsBatch = stream.buffer.empty();
+            stream.buffer += color;
+            for(const auto& segment : record)
+                stream.buffer += segment;
+            if(!color.empty())
+                stream.buffer += COLOR_RESET;
+            stream.buffer += '\n';
+
+            if(stream.tty || stream.buffer.size() >= options.batchBytes || level >= options.flushLevel) {
+                writeStream(stream);
+                return;
+            }
+
+            if(startsBatch) {
+                stream.batchStart = std::chrono::steady_clock::now();
+                armTimer();
+            }
+        }
+
+        // Only one Stream holds a Batch at a Time (writeRecord writes the other one first)
+        inline void runTimer() {
+            std::unique_lock<std::mutex> lock(chainMutex());
+            while(!stopTimer) {
+                Stream* batched = !out.buffer.empty() ? &out : !err.buffer.empty() ? &err : nullptr;
+                if(!batched) {
+                    wakeTimer.wait(lock);
+                    continue;
+                }
+                auto deadline = batched->batchStart + options.maxDelay;
+                if(std::chrono::steady_clock::now() < deadline) {
+                    wakeTimer.wait_until(lock, deadline);
+                    continue;                   // The Batch may have been written (and a new one started) meanwhile
+                }
+                writeStream(*batched);
+            }
+        }
+
+        // Called with the Chain-Mutex held
+        inline void armTimer() {
+            if(!timer.joinable())
+                timer = std::thread([this]() { runTimer(); });
+            else
+                wakeTimer.notify_one();
+        }
+
     protected:
         inline void log(const std::string& message) override {
             // Print no newline here. Our Base-Logger will take care of it
-            std::cout << message;
-            std::cout.flush();
+            if(message != "\n") {
+                fragments += message;
+                return;
+            }
+            ownSegments.clear();
+            ownSegments.emplace_back(fragments);
+            writeRecord(ownSegments);
+            fragments.clear();
+        }
+
+        inline void logSegments(BLogSegments& segments) override {
+            writeRecord(segments);
+        }
+
+        inline void flushOutput() override {
+            writeStream(out);
+            writeStream(err);
         }
 
     public:
-        inline explicit BConsoleLogger(const std::string& name) : BLogger(name) {}
+        inline explicit BConsoleLogger(const std::string& name, const BConsoleOptions& consoleOptions = BConsoleOptions())
+            : BLogger(name), options(consoleOptions), out(openStream(consoleOptions.outFd)), err(openStream(consoleOptions.errFd)) {
+            out.buffer.reserve(out.tty ? 256 : options.batchBytes);
+        }
+
+        inline virtual ~BConsoleLogger() {
+            {
+                std::lock_guard<std::mutex> lock(chainMutex());
+                stopTimer = true;
+            }
+            wakeTimer.notify_one();
+            if(timer.joinable())
+                timer.join();
+            flushOutput();
+        }
 
+        inline bool isColored() const {
+            return out.colored;
+        }
 };
 
 #endif
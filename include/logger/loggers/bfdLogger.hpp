@@ -0,0 +1,152 @@
+#ifndef BFD_LOGGER_HPP
+#define BFD_LOGGER_HPP
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "../blogger.hpp"
+
+// POSIX-only Sink on a plain File-Descriptor.
+//
+// Records arrive as Segments (Prefixes of the Decorators + Body, see BLogSegments) and are written
+// with a single writev, the Newline as its own Segment - nothing is concatenated into a temporary String.
+// Opened with O_APPEND (default) every writev goes to the current End of the File in one Piece, so several
+// Processes can share one File without tearing Records apart (as long as the File is on a local Filesystem).
+//
+// With batchBytes > 0 the Segments of several Records are gathered in a preallocated Buffer instead
+// and written in one Go once it is full (or on flush()/Destruction) - fewer Syscalls, one memcpy per Segment.
+// Records larger than the Buffer bypass it and are still written in one writev
+class BFdLogger : public BLogger {
+    private:
+        int fd;
+        bool ownsFd;
+        size_t batchBytes;
+
+        std::string batch;                  // Only used with batchBytes > 0, never grows beyond batchBytes
+        std::string fragments;              // Fragments of an undecorated Chain (log() instead of logSegments())
+        std::vector<iovec> iov;
+        BLogSegments ownSegments;
+
+        // Retry until everything is written, writev might only write Parts (Signals, full Pipes...)
+        inline void writeAll(iovec* vec, size_t count) {
+            while(count > 0) {
+                ssize_t written = ::writev(fd, vec, static_cast<int>(count < IOV_MAX ? count : IOV_MAX));
+                if(written < 0) {
+                    if(errno == EINTR)
+                        continue;
+                    return;                 // Nothing sensible left to do, a Logger must not throw mid Record
+                }
+
+                size_t remaining = static_cast<size_t>(written);
+                while(count > 0 && remaining >= vec->iov_len) {
+                    remaining -= vec->iov_len;
+                    vec++;
+                    count--;
+                }
+                if(count > 0) {
+                    vec->iov_base = static_cast<char*>(vec->iov_base) + remaining;
+                    vec->iov_len -= remaining;
+                }
+            }
+        }
+
+        inline void writeBatch() {
+            if(batch.empty())
+                return;
+            iovec single{batch.data(), batch.size()};
+            writeAll(&single, 1);
+            batch.clear();
+        }
+
+        inline void writeRecord(const BLogSegments& record) {
+            size_t size = 1;
+            for(const auto& segment : record)
+                size += segment.size();
+
+            if(batchBytes > 0 && size <= batchBytes) {
+                if(batch.size() + size > batchBytes)
+                    writeBatch();
+                for(const auto& segment : record)
+                    batch.append(segment.data(), segment.size());
+                batch += '\n';
+                return;
+            }
+
+            // Keep the Order if something is still batched
+            writeBatch();
+
+            iov.clear();
+            for(const auto& segment : record) {
+                if(!segment.empty())
+                    iov.push_back(iovec{const_cast<char*>(segment.data()), segment.size()});
+            }
+            static const char newline = '\n';
+            iov.push_back(iovec{const_cast<char*>(&newline), 1});
+            writeAll(iov.data(), iov.size());
+        }
+
+    protected:
+        inline void log(const std::string& message) override {
+            if(message != "\n") {
+                fragments += message;
+                return;
+            }
+            ownSegments.clear();
+            ownSegments.emplace_back(fragments);
+            writeRecord(ownSegments);
+            fragments.clear();
+        }
+
+        inline void logSegments(BLogSegments& segments) override {
+            writeRecord(segments);
+        }
+
+        inline void flushOutput() override {
+            writeBatch();
+        }
+
+    public:
+        // Open (and own) the File at path
+        inline BFdLogger(const std::string& name, const std::string& path, bool append = true, size_t batchSize = 0)
+            : BLogger(name), fd(-1), ownsFd(true), batchBytes(batchSize) {
+            int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+            fd = ::open(path.c_str(), flags, 0644);
+            if(fd < 0)
+                throw std::runtime_error("Could not open log file: " + path + " (" + std::strerror(errno) + ")");
+            batch.reserve(batchBytes);
+        }
+
+        // Use an already open Descriptor (e.g. STDERR_FILENO). Only closed if takeOwnership is set
+        inline BFdLogger(const std::string& name, int descriptor, bool takeOwnership = false, size_t batchSize = 0)
+            : BLogger(name), fd(descriptor), ownsFd(takeOwnership), batchBytes(batchSize) {
+            if(fd < 0)
+                throw std::invalid_argument("Invalid file descriptor");
+            batch.reserve(batchBytes);
+        }
+
+        // The Descriptor (and with ownsFd closing it) belongs to exactly one Logger, a Copy would close it twice
+        BFdLogger(const BFdLogger&) = delete;
+        BFdLogger& operator=(const BFdLogger&) = delete;
+        BFdLogger(BFdLogger&&) = delete;
+        BFdLogger& operator=(BFdLogger&&) = delete;
+
+        inline virtual ~BFdLogger() {
+            writeBatch();
+            if(ownsFd && fd >= 0)
+                ::close(fd);
+        }
+
+        inline int getFd() const {
+            return fd;
+        }
+};
+
+#endif
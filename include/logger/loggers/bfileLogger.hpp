@@ -3,19 +3,53 @@
 
 #include <fstream>
 #include <filesystem>
+#include <memory>
 
 #include "../blogger.hpp"
+#include "../blogIndex.hpp"
 
 class BFileLogger : public BLogger {
     private:
         std::ofstream file;
 
+        // Only with an Index: Byte-Offset of the File and of the Record currently written
+        std::unique_ptr<BLogIndexWriter> index;
+        uint64_t offset = 0;
+        uint64_t recordStart = 0;
+        bool inRecord = false;
+
     protected:
+        // Raw Access to the File for Loggers building on this one (e.g. BCompressedFileLogger)
+        inline void writeFile(const char* data, size_t size) {
+            if(file.is_open()) {
+                file.write(data, static_cast<std::streamsize>(size));
+                file.flush();
+            }
+        }
+
         inline void log(const std::string& message) override {
             if(file.is_open()) {
                 file << message;
                 file.flush();
             }
+
+            if(index) {
+                if(!inRecord) {
+                    recordStart = offset;
+                    inRecord = true;
+                }
+                offset += message.size();
+                if(message == "\n") {
+                    index->add(recordStart, offset, getLogLevel(), getTopic(), BLogIndex::nowMs());
+                    inRecord = false;
+                }
+            }
+        }
+
+        // Everything logged so far is findable through the Index afterwards
+        inline void flushOutput() override {
+            if(index)
+                index->sync();
         }
 
     public:
@@ -31,6 +65,13 @@ class BFileLogger : public BLogger {
             }
         }
 
+        // Same, but also writes the Sidecar Index <filename>.idx (see BLogIndex) for blogquery
+        inline BFileLogger(const std::string& name, const std::string& filename, const BLogIndexOptions& indexOptions)
+            : BFileLogger(name, filename) {
+            offset = std::filesystem::file_size(filename);
+            index = std::make_unique<BLogIndexWriter>(filename + ".idx", indexOptions);
+        }
+
         inline virtual ~BFileLogger() {
             if(file.is_open()) {
                 file.close();
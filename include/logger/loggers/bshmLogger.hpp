@@ -0,0 +1,54 @@
+#ifndef BSHM_LOGGER_HPP
+#define BSHM_LOGGER_HPP
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "../blogger.hpp"
+#include "../bshmRing.hpp"
+
+// Linux-only Sink publishing every Record into a BShmRing, to be written by a BShmCollector in
+// another (or the same) Process. Any Number of Processes can log into the same Ring.
+//
+// Decorators still run in the logging Process, the Segments are copied into the Ring directly.
+// With Overflow::DROP (default) a Record that finds the Ring full is dropped and counted in the Ring.
+// With Overflow::BLOCK the Logger waits for the Collector, but at most blockTimeout: it holds the
+// Chain-Mutex meanwhile, so a crashed or missing Collector would otherwise hang all Logging
+class BShmLogger : public BLogger {
+    private:
+        BShmRing ring;
+        BShmRing::Overflow overflow;
+        std::chrono::milliseconds blockTimeout;
+
+        std::string fragments;              // Fragments of an undecorated Chain (log() instead of logSegments())
+        BLogSegments ownSegments;
+
+    protected:
+        inline void log(const std::string& message) override {
+            if(message != "\n") {
+                fragments += message;
+                return;
+            }
+            ownSegments.clear();
+            ownSegments.emplace_back(fragments);
+            ring.publish(ownSegments, getLogLevel(), overflow, blockTimeout);
+            fragments.clear();
+        }
+
+        inline void logSegments(BLogSegments& segments) override {
+            ring.publish(segments, getLogLevel(), overflow, blockTimeout);
+        }
+
+    public:
+        // Opens the Ring or creates it with the given Geometry (see BShmRing)
+        inline BShmLogger(const std::string& name, const std::string& ringName, BShmRing::Overflow whenFull = BShmRing::Overflow::DROP,
+                uint32_t slotCount = 4096, uint32_t slotSize = 256, std::chrono::milliseconds waitAtMost = std::chrono::seconds(1))
+            : BLogger(name), ring(ringName, slotCount, slotSize), overflow(whenFull), blockTimeout(waitAtMost) {}
+
+        inline uint64_t dropped() const {
+            return ring.dropped();
+        }
+};
+
+#endif
@@ -1,22 +1,15 @@
 #ifndef BINARY_B_MSG_HPP
 #define BINARY_B_MSG_HPP
 
-#include <bitset>
-
-#include "../bloggerMessage.hpp"
+#include "radixBMsg.hpp"
 
+// Logs the Value as Binary, e.g. BinaryBMsg(uint8_t(42)) -> 00101010
+// With a groupSize the Bits are split up for readability, e.g. BinaryBMsg(uint8_t(42), 4) -> 0010 1010
 template<typename T>
-class BinaryBMsg : public BLogMessage {
-    private:
-        const T value;
-    
+class BinaryBMsg : public RadixBMsg<T, 1> {
     public:
-        explicit BinaryBMsg(T v) : value(v) {}
-        const std::string serialize() const override {
-            constexpr size_t bits = sizeof(T) * 8;
-            // return as Binary Format
-            return std::bitset<bits>(value).to_string(); 
-        }
+        explicit BinaryBMsg(T v, size_t groupSize = 0, char separator = ' ')
+            : RadixBMsg<T, 1>(v, groupSize, separator, "") {}
 };
 
 #endif
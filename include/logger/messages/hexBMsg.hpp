@@ -0,0 +1,14 @@
+#ifndef HEX_B_MSG_HPP
+#define HEX_B_MSG_HPP
+
+#include "radixBMsg.hpp"
+
+// Logs the Value as zero padded Hex, e.g. HexBMsg(42) -> 0x0000002a
+template<typename T>
+class HexBMsg : public RadixBMsg<T, 4> {
+    public:
+        explicit HexBMsg(T v, bool withPrefix = true, size_t groupSize = 0, char separator = ' ')
+            : RadixBMsg<T, 4>(v, groupSize, separator, withPrefix ? "0x" : "") {}
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef OCTAL_B_MSG_HPP
+#define OCTAL_B_MSG_HPP
+
+#include "radixBMsg.hpp"
+
+// Logs the Value as zero padded Octal, e.g. OctalBMsg(uint8_t(42)) -> 052
+// The Width is rounded up to full Digits, so the leading Digit may cover less than 3 Bits
+template<typename T>
+class OctalBMsg : public RadixBMsg<T, 3> {
+    public:
+        explicit OctalBMsg(T v, bool withPrefix = false, size_t groupSize = 0, char separator = ' ')
+            : RadixBMsg<T, 3>(v, groupSize, separator, withPrefix ? "0" : "") {}
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef RADIX_B_MSG_HPP
+#define RADIX_B_MSG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "../bloggerMessage.hpp"
+
+// Common Base for all "print the raw Bits of a Value" Messages (Binary, Octal, Hex).
+// Writes the Digits straight into the Buffer of the Chain - no bitset, no temporary Strings.
+// Width is always fixed to the full Size of T, so 42 as int is 32 Binary-Digits long
+template<typename T, unsigned BitsPerDigit>
+class RadixBMsg : public BLogBufferedMessage {
+    static_assert(BitsPerDigit >= 1 && BitsPerDigit <= 4, "Only Radix 2, 4, 8 and 16 are supported");
+    static_assert(sizeof(T) <= sizeof(unsigned long long), "Type is too large to be printed digit by digit");
+
+    protected:
+        const T value;
+        const size_t groupSize;             // Digits per Group, 0 means no Grouping
+        const char separator;
+        const char* prefix;
+
+        static constexpr size_t bits = sizeof(T) * 8;
+        static constexpr size_t digits = (bits + BitsPerDigit - 1) / BitsPerDigit;
+
+        // Everything else (float, double, ...) prints its Representation in Memory, not the converted Value
+        static unsigned long long objectBits(const T& v) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable Types have raw Bits");
+            using Unsigned = std::conditional_t<sizeof(T) == 1, uint8_t,
+                             std::conditional_t<sizeof(T) == 2, uint16_t,
+                             std::conditional_t<sizeof(T) <= 4, uint32_t, uint64_t>>>;
+            Unsigned bits = 0;
+            std::memcpy(&bits, &v, sizeof(T));
+            return bits;
+        }
+
+        // Reinterpret everything as unsigned so negative Values print their two's complement
+        static unsigned long long rawBits(T v) {
+            if constexpr(std::is_same<T, bool>::value)
+                return v ? 1 : 0;
+            else if constexpr(std::is_enum<T>::value)
+                return static_cast<std::make_unsigned_t<std::underlying_type_t<T>>>(v);
+            else if constexpr(std::is_integral<T>::value)
+                return static_cast<std::make_unsigned_t<T>>(v);
+            else
+                return objectBits(v);
+        }
+
+        RadixBMsg(T v, size_t group, char sep, const char* pre)
+            : value(v), groupSize(group), separator(sep), prefix(pre) {}
+
+    public:
+        size_t sizeHint() const override {
+            size_t separators = (groupSize > 0) ? (digits - 1) / groupSize : 0;
+            return std::char_traits<char>::length(prefix) + digits + separators;
+        }
+
+        void serializeTo(std::string& buffer) const override {
+            static constexpr char DIGITS[] = "0123456789abcdef";
+            constexpr unsigned long long mask = (1ull << BitsPerDigit) - 1;
+
+            const unsigned long long v = rawBits(value);
+            buffer += prefix;
+            for(size_t i = 0; i < digits; i++) {
+                if(groupSize > 0 && i != 0 && (digits - i) % groupSize == 0)
+                    buffer += separator;
+                size_t shift = (digits - 1 - i) * BitsPerDigit;
+                buffer += DIGITS[(v >> shift) & mask];
+            }
+        }
+};
+
+#endif
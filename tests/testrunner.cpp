@@ -1,4 +1,11 @@
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -6,14 +13,33 @@
 #include <unordered_set>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include "../include/logger/bloggerManager.hpp"
 #include "../include/logger/blogContext.hpp"
+#include "../include/logger/blogSpan.hpp"
+#include "../include/logger/bshmCollector.hpp"
+#include "../include/logger/blogTaskContext.hpp"
+#include "../include/logger/bloggerFormat.hpp"
 #include "../include/logger/loggers/bconsoleLogger.hpp"
 #include "../include/logger/loggers/bfileLogger.hpp"
+#include "../include/logger/loggers/bcompressedFileLogger.hpp"
+#include "../include/logger/loggers/bfdLogger.hpp"
+#include "../include/logger/loggers/bshmLogger.hpp"
 #include "../include/logger/messages/binaryBMsg.hpp"
+#include "../include/logger/messages/hexBMsg.hpp"
+#include "../include/logger/messages/octalBMsg.hpp"
 #include "../include/logger/decorators/btimestampDecorator.hpp"
 #include "../include/logger/decorators/bloglevelDecorator.hpp"
 #include "../include/logger/decorators/blocationDecorator.hpp"
+#include "../include/logger/decorators/bsanitizeDecorator.hpp"
+#include "../include/logger/decorators/bbacktraceDecorator.hpp"
+#include "../include/logger/decorators/basyncDecorator.hpp"
+#include "../include/logger/decorators/brepeatDecorator.hpp"
+
+#include "../tools/blogquery.hpp"
 
 #include "tests.ipp"
 
@@ -99,6 +125,19 @@ int main(int argc, char *argv[]) {
     runner.addTest("5TopicsAndFreeze", testTopicsAndFreeze, {"1LoggerManager", "4LogLevels"}, true);
     runner.addTest("6EaseOfUse", testEaseOfUsePt1, {"1LoggerManager", "4LogLevels"}, true);
     runner.addTest("7LocationLogger", testLocationLogger, {}, true);
+    runner.addTest("8Sanitizer", testSanitizer, {}, true);
+    runner.addTest("9TaskContext", testTaskContext, {}, true);
+    runner.addTest("10Backtrace", testBacktrace, {}, true);
+    runner.addTest("11AsyncDeferred", testAsyncDeferred, {}, true);
+    runner.addTest("12FdLogger", testFdLogger, {}, true);
+    runner.addTest("13Format", testFormat, {}, true);
+    runner.addTest("14ConsoleLogger", testConsoleLogger, {}, true);
+    runner.addTest("15Repeat", testRepeat, {}, true);
+    runner.addTest("16Span", testSpan, {}, true);
+    runner.addTest("17ShmRing", testShmRing, {}, true);
+    runner.addTest("18LogIndex", testLogIndex, {}, true);
+    runner.addTest("19CompressedFile", testCompressedFile, {}, true);
+    runner.addTest("20AsyncPool", testAsyncPool, {}, true);
 
     if(argc != 1) {
         for(int i = 1; i < argc; i++) {
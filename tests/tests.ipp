@@ -1,6 +1,33 @@
 #ifndef TESTS_IPP
 #define TESTS_IPP
 
+// Sink that just keeps everything it gets, so the fully decorated Output can be checked
+class CaptureLogger : public BLogger {
+    protected:
+        inline void log(const std::string& message) override {
+            output += message;
+        }
+
+    public:
+        std::string output;
+
+        inline explicit CaptureLogger(const std::string& name) : BLogger(name) {}
+};
+
+// Level and Topics a Test changes go back to their Defaults when it ends, also without LOGGER_DEBUG
+struct ConfigRestore {
+    ~ConfigRestore() {
+        BLoggerConfig::setDefaultLogLevel(BLogLevel::NONE);
+        BLoggerConfig::setTopics({});
+    }
+};
+
+// Path in ./log for the File-Based Tests, the Directory is created if it is not there yet
+std::string logPath(const std::string& file) {
+    std::filesystem::create_directories("./log");
+    return "./log/" + file;
+}
+
 void testBinaryMessage(std::shared_ptr<BLogger> lg) {
     std::cout << "Test Binary Message: \n";
 
@@ -12,6 +39,55 @@ void testBinaryMessage(std::shared_ptr<BLogger> lg) {
     assert(lg->getLastMessage() == "0000000000000000000000000000000000000000000000000000000000101010");
     *lg << BinaryBMsg(uint8_t(42));
     assert(lg->getLastMessage() == "00101010");
+    *lg << BinaryBMsg(-1);
+    assert(lg->getLastMessage() == "11111111111111111111111111111111");
+    assert(BinaryBMsg('A').serialize() == "01000001");
+
+    // Grouped, Hex and Octal Variants
+    *lg << BinaryBMsg(uint16_t(42), 4);
+    assert(lg->getLastMessage() == "0000 0000 0010 1010");
+    *lg << BinaryBMsg(uint8_t(42), 4, '_');
+    assert(lg->getLastMessage() == "0010_1010");
+    *lg << HexBMsg(42);
+    assert(lg->getLastMessage() == "0x0000002a");
+    *lg << HexBMsg(uint16_t(0xBEEF), false);
+    assert(lg->getLastMessage() == "beef");
+    *lg << HexBMsg(0xDEADBEEFu, true, 4, '\'');
+    assert(lg->getLastMessage() == "0xdead'beef");
+    *lg << OctalBMsg(uint8_t(42));
+    assert(lg->getLastMessage() == "052");
+    *lg << OctalBMsg(uint16_t(8), true);
+    assert(lg->getLastMessage() == "0000010");
+    *lg << "Mixed " << HexBMsg(uint8_t(255)) << " " << OctalBMsg(uint8_t(7));
+    assert(lg->getLastMessage() == "Mixed 0xff 007");
+
+    // Custom Message only implementing serializeTo
+    struct PointMsg : public BLogBufferedMessage {
+        int x, y;
+        PointMsg(int px, int py) : x(px), y(py) {}
+        size_t sizeHint() const override { return 16; }
+        void serializeTo(std::string& buffer) const override {
+            buffer += "(";
+            buffer += std::to_string(x);
+            buffer += "|";
+            buffer += std::to_string(y);
+            buffer += ")";
+        }
+    };
+    *lg << "Point " << PointMsg(1, -2);
+    assert(lg->getLastMessage() == "Point (1|-2)");
+    assert(PointMsg(3, 4).serialize() == "(3|4)");
+
+    // Floating Point Values print their Bits, not the converted Value
+    assert(HexBMsg(1.0f).serialize() == "0x3f800000");
+    assert(HexBMsg(-2.0).serialize() == "0xc000000000000000");
+
+    // Old style Message only implementing serialize still works through the default adapter
+    struct LegacyMsg : public BLogMessage {
+        const std::string serialize() const override { return "legacy"; }
+    };
+    *lg << LegacyMsg() << " " << LegacyMsg();
+    assert(lg->getLastMessage() == "legacy legacy");
 }
 
 void testBLoggerManager() {
@@ -399,4 +475,1385 @@ void testLocationLogger() {
     std::cout << "Location logger tests completed!\n";
 }
 
+void testSanitizer() {
+    std::cout << "Test Sanitizer:\n";
+
+    using S = BLoggerSanitizer;
+
+    // Clean Input passes untouched, also across the SIMD Block Boundaries
+    std::string clean(100, 'a');
+    assert(S::isClean(clean));
+    assert(S::sanitized(clean) == clean);
+    for(size_t pos = 0; pos < clean.size(); pos++) {
+        std::string dirty = clean;
+        dirty[pos] = '\n';
+        assert(S::findUnsafe(dirty.data(), dirty.size()) == pos);
+        assert(S::findUnsafeScalar(dirty.data(), dirty.size()) == pos);
+    }
+
+    // Control Characters and Backslashes
+    assert(S::sanitized("line1\nline2") == "line1\\nline2");
+    assert(S::sanitized("a\tb\rc") == "a\\tb\\rc");
+    assert(S::sanitized("esc\x1b[31m") == "esc\\x1b[31m");
+    assert(S::sanitized(std::string("nul\0x", 5)) == "nul\\x00x");
+    assert(S::sanitized("back\\slash") == "back\\\\slash");
+    assert(S::sanitized("del\x7f") == "del\\x7f");
+
+    // UTF-8: valid Sequences stay, invalid Bytes get escaped
+    assert(S::sanitized("gr\xc3\xbc\xc3\x9f \xe2\x82\xac \xf0\x9f\x98\x80") == "gr\xc3\xbc\xc3\x9f \xe2\x82\xac \xf0\x9f\x98\x80");
+    assert(S::sanitized("bad\xff") == "bad\\xff");
+    assert(S::sanitized("overlong\xc0\xaf") == "overlong\\xc0\\xaf");
+    assert(S::sanitized("surrogate\xed\xa0\x80") == "surrogate\\xed\\xa0\\x80");
+    assert(S::sanitized("cut\xe2\x82") == "cut\\xe2\\x82");
+
+    // Length Cap includes the Marker and never splits an Escape or a UTF-8 Sequence
+    S::Options capped;
+    capped.maxLength = 8;
+    assert(S::sanitized("0123456789", capped) == "01234...");
+    assert(S::sanitized("0123456\n", capped) == "01234...");
+    assert(S::sanitized("012345\xc3\xbc", capped) == "012345\xc3\xbc");
+    assert(S::sanitized("0123456\xc3\xbc", capped) == "01234...");
+    assert(S::sanitized("0123\xc3\xbc\xc3\xbc\xc3\xbc", capped) == "0123...");
+    assert(S::sanitized("01\n\n\n\n", capped) == "01\\n...");
+    assert(S::sanitized("short", capped) == "short");
+    for(std::string in : {"0123456789abc", "\n\n\n\n\n", "\xff\xff\xff", "01234\t\t"})
+        assert(S::sanitized(in, capped).size() <= capped.maxLength);
+
+    // As outermost Decorator: Record stays on one Line, Prefixes of the inner Decorators are untouched
+    auto sink = std::make_shared<CaptureLogger>("sanitize_capture");
+    auto lg = BSanitizeDecorator::decorate(BLoglevelDecorator::decorate(sink), capped);
+    (*lg)[BLogLevel::ERROR] << "user: " << "evil\ninjected";
+    assert(sink->output == "[ERROR] user:...\n");
+
+    sink->output.clear();
+    (*lg)[BLogLevel::ERROR] << "ok";
+    assert(sink->output == "[ERROR] ok\n");
+
+    // A Payload that is exactly "\n" is escaped as well, it neither ends nor splits the Record
+    auto uncapped = BSanitizeDecorator::decorate(BLoglevelDecorator::decorate(sink));
+    std::string untrusted = "\n";
+    sink->output.clear();
+    (*uncapped)[BLogLevel::ERROR] << "user: " << untrusted << "[ERROR] forged";
+    assert(sink->output == "[ERROR] user: \\n[ERROR] forged\n");
+    sink->output.clear();
+    (*uncapped)[BLogLevel::ERROR] << untrusted;
+    assert(sink->output == "[ERROR] \\n\n");
+
+    // Same with another Decorator stacked above the Sanitizer
+    auto stacked = BLoglevelDecorator::decorate(BSanitizeDecorator::decorate(sink));
+    sink->output.clear();
+    (*stacked)[BLogLevel::ERROR] << "user: " << untrusted << "[ERROR] forged";
+    assert(sink->output == "[ERROR] user: \\n[ERROR] forged\n");
+}
+
+void testTaskContext() {
+    std::cout << "Test Task Context:\n";
+    ConfigRestore restore;
+
+    auto sink = std::make_shared<CaptureLogger>("task_capture");
+    auto lg = BLoglevelDecorator::decorate(sink);
+
+    BLogTaskContext ctx(lg, "network", BLogLevel::INFO, "4711");
+    auto userCtx = ctx.withField("user", "bob").withField("attempt", 2);
+
+    userCtx << "Request done in " << 12 << "ms";
+    assert(sink->output == "[INFO] [req=4711] [user=bob] [attempt=2] Request done in 12ms\n");
+    sink->output.clear();
+
+    // Original Context is untouched by the derived ones
+    ctx.error() << "Plain " << BinaryBMsg(uint8_t(5));
+    assert(sink->output == "[ERROR] [req=4711] Plain 00000101\n");
+    sink->output.clear();
+
+    // Filters of BLoggerConfig apply, disabled Records don't even format
+    BLoggerConfig::setDefaultLogLevel(BLogLevel::INFO);
+    auto dbg = ctx.debug();
+    assert(!dbg.enabled());
+    dbg << "Invisible";
+    BLoggerConfig::setTopics({"database"});
+    ctx.error() << "Wrong topic";
+    assert(lg->isEnabled(BLogLevel::INFO, "database") && !lg->isEnabled(BLogLevel::INFO, "network"));
+    BLoggerConfig::setTopics({});
+    assert(sink->output.empty());
+
+    // The per Thread State of the Chain is not touched
+    (*lg)("chain_topic");
+    ctx.warning() << "Does not change the chain";
+    assert(lg->getTopic() == "chain_topic");
+    (*lg) << "reset";
+    sink->output.clear();
+
+    // Records started on one Thread and finished on another (like a resumed Coroutine)
+    std::vector<std::thread> threads;
+    std::vector<BLogTaskContext::Record> pending;
+    for(int i = 0; i < 4; i++)
+        pending.push_back(std::move(ctx.withRequestId("task" + std::to_string(i)).info() << "started on main"));
+
+    for(int i = 0; i < 4; i++) {
+        threads.emplace_back([record = std::move(pending[i]), i]() mutable {
+            record << ", finished on worker " << i;
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    for(int i = 0; i < 4; i++) {
+        std::string line = "[INFO] [req=task" + std::to_string(i) + "] started on main, finished on worker " + std::to_string(i) + "\n";
+        assert(sink->output.find(line) != std::string::npos);
+    }
+
+    // Contexts captured by many Tasks at once
+    sink->output.clear();
+    threads.clear();
+    for(int i = 0; i < 8; i++) {
+        threads.emplace_back([taskCtx = ctx.withField("task", i)]() {
+            for(int j = 0; j < 100; j++)
+                taskCtx.info() << "msg " << j;
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    size_t lines = 0;
+    for(char c : sink->output)
+        lines += (c == '\n');
+    assert(lines == 800);
+}
+
+void testBacktrace() {
+    std::cout << "Test Backtrace:\n";
+    ConfigRestore restore;
+
+    BLoggerConfig::setDefaultLogLevel(BLogLevel::INFO);
+
+    // Level-Decorator outside: Records are stored already formatted
+    auto sink = std::make_shared<CaptureLogger>("backtrace_capture");
+    auto lg = BLoglevelDecorator::decorate(BBacktraceDecorator::decorate(sink, 3));
+
+    for(int i = 0; i < 5; i++)
+        (*lg)[BLogLevel::DEBUG] << "step " << i;
+    assert(sink->output.empty());
+    assert(lg->getLastMessage() == "step 4");
+
+    (*lg)[BLogLevel::INFO] << "visible";
+    assert(sink->output == "[INFO] visible\n");
+    sink->output.clear();
+
+    (*lg)[BLogLevel::ERROR] << "boom";
+    assert(sink->output == "[DEBUG] step 2\n[DEBUG] step 3\n[DEBUG] step 4\n[ERROR] boom\n");
+    sink->output.clear();
+
+    // Ring was emptied by the Dump
+    (*lg)[BLogLevel::ERROR] << "boom again";
+    assert(sink->output == "[ERROR] boom again\n");
+    sink->output.clear();
+
+    // One Ring per Topic
+    (*lg)("net")[BLogLevel::DEBUG] << "net detail";
+    (*lg)("disk")[BLogLevel::DEBUG] << "disk detail";
+    (*lg)("net")[BLogLevel::ERROR] << "net failed";
+    assert(sink->output == "[DEBUG] net detail\n[ERROR] net failed\n");
+    sink->output.clear();
+
+    // Topic Filter still applies, filtered Topics are not even stored
+    BLoggerConfig::setTopics({"net"});
+    (*lg)("other")[BLogLevel::DEBUG] << "not stored";
+    (*lg)("other")[BLogLevel::ERROR] << "not shown";
+    assert(sink->output.empty());
+    BLoggerConfig::setTopics({});
+    (*lg)("disk")[BLogLevel::ERROR] << "disk failed";
+    assert(sink->output == "[DEBUG] disk detail\n[ERROR] disk failed\n");
+    sink->output.clear();
+
+    // Level-Decorator inside: Records are stored raw and formatted with their original Level when dumped
+    auto rawSink = std::make_shared<CaptureLogger>("backtrace_raw_capture");
+    auto raw = BBacktraceDecorator::decorate(BLoglevelDecorator::decorate(rawSink), 8, BLogLevel::WARNING, BBacktraceDecorator::Scope::PER_THREAD);
+    (*raw)[BLogLevel::LOG] << "raw detail";
+    (*raw)[BLogLevel::WARNING] << "warned";
+    assert(rawSink->output == "[LOG] raw detail\n[WARNING] warned\n");
+
+    // Level configured for the outer Logger counts: a WARNING below it is only stored, never written
+    auto gateSink = std::make_shared<CaptureLogger>("backtrace_gate_capture");
+    auto gated = BLoglevelDecorator::decorate(BBacktraceDecorator::decorate(gateSink, 4, BLogLevel::WARNING));
+    BLoggerConfig::setLoggerLevel(gated->getName(), BLogLevel::ERROR);
+    (*gated)[BLogLevel::DEBUG] << "detail";
+    (*gated)[BLogLevel::WARNING] << "warned";
+    assert(gateSink->output.empty());
+    (*gated)[BLogLevel::ERROR] << "failed";
+    assert(gateSink->output == "[DEBUG] detail\n[WARNING] warned\n[ERROR] failed\n");
+
+    // Same through an Async Decorator, the Writer-Thread filters against the Level of the Producer Side
+    gateSink->output.clear();
+    auto asyncGated = BAsyncDecorator::decorate(BLoglevelDecorator::decorate(BBacktraceDecorator::decorate(gateSink, 4, BLogLevel::WARNING)));
+    BLoggerConfig::setLoggerLevel(asyncGated->getName(), BLogLevel::ERROR);
+    (*asyncGated)[BLogLevel::WARNING] << "async warned";
+    asyncGated->flushQueue();
+    assert(gateSink->output.empty());
+    (*asyncGated)[BLogLevel::ERROR] << "async failed";
+    asyncGated->flushQueue();
+    assert(gateSink->output == "[WARNING] async warned\n[ERROR] async failed\n");
+
+    // At most ringLimit Rings, the least recently used one is dropped. Topics are kept apart by their Name
+    auto boundSink = std::make_shared<CaptureLogger>("backtrace_bound_capture");
+    auto bound = BLoglevelDecorator::decorate(BBacktraceDecorator::decorate(boundSink, 4, BLogLevel::ERROR, BBacktraceDecorator::Scope::PER_TOPIC, 2));
+    (*bound)("a")[BLogLevel::DEBUG] << "a detail";
+    (*bound)("b")[BLogLevel::DEBUG] << "b detail";
+    (*bound)("a")[BLogLevel::DEBUG] << "a more";
+    (*bound)("c")[BLogLevel::DEBUG] << "c detail";        // Drops the Ring of b
+    (*bound)("a")[BLogLevel::ERROR] << "a failed";
+    (*bound)("b")[BLogLevel::ERROR] << "b failed";
+    assert(boundSink->output == "[DEBUG] a detail\n[DEBUG] a more\n[ERROR] a failed\n[ERROR] b failed\n");
+
+    try {
+        BBacktraceDecorator::decorate(boundSink, 4, BLogLevel::ERROR, BBacktraceDecorator::Scope::PER_TOPIC, 0);
+        assert(false);
+    } catch(const std::invalid_argument&) { }
+
+    // Normal Loggers are unaffected
+    auto plainSink = std::make_shared<CaptureLogger>("backtrace_plain_capture");
+    (*plainSink)[BLogLevel::DEBUG] << "dropped";
+    assert(plainSink->output.empty());
+}
+
+// Throws on "bad", counts Records up to the last Flush and can hold the Writer in the first Record
+class ThrowingLogger : public BLogger {
+    protected:
+        inline void log(const std::string& message) override {
+            if(blockOnFirst && !blocked) {
+                blocked = true;
+                while(!release)
+                    std::this_thread::yield();
+            }
+            if(message == "bad")
+                throw std::runtime_error("sink failed");
+            output += message;
+        }
+
+        inline void flushOutput() override {
+            flushedAt = 0;
+            for(char c : output)
+                flushedAt += (c == '\n');
+        }
+
+    public:
+        std::string output;
+        size_t flushedAt = 0;
+        bool blockOnFirst = false;
+        std::atomic<bool> blocked{false};
+        std::atomic<bool> release{false};
+
+        inline explicit ThrowingLogger(const std::string& name) : BLogger(name) {}
+};
+
+void testAsyncDeferred() {
+    std::cout << "Test Async and Deferred Formatting:\n";
+    ConfigRestore restore;
+
+    auto sink = std::make_shared<CaptureLogger>("async_capture");
+    auto async = BAsyncDecorator::decorate(BLoglevelDecorator::decorate(sink));
+
+    // Normal Chain: formatted on the caller, decorated and written on the Writer-Thread
+    (*async)[BLogLevel::INFO] << "chain " << 1;
+    async->flushQueue();
+    assert(sink->output == "[INFO] chain 1\n");
+    sink->output.clear();
+
+    // Deferred: only the raw Arguments are captured
+    std::string str = " str";
+    BinaryBMsg<uint8_t> bin(3);
+    BLOG_DEFERRED(async, "", BLogLevel::WARNING) << "x=" << 42 << " u=" << 7u << " pi=" << 3.5 << " ok=" << true
+                                                << ' ' << 'c' << str << " " << bin << " " << HexBMsg(uint8_t(255));
+    async->flushQueue();
+    assert(sink->output == "[WARNING] x=42 u=7 pi=3.5 ok=1 c str 00000011 0xff\n");
+    sink->output.clear();
+
+    // Arguments that don't fit inline anymore keep their Order
+    std::string longText(200, 'l');
+    BLOG_DEFERRED(async, "", BLogLevel::INFO) << "a" << longText << "b" << 1;
+    async->flushQueue();
+    assert(sink->output == "[INFO] a" + longText + "b1\n");
+    sink->output.clear();
+
+    BDeferredRecord record;
+    record.push(1);
+    record.push("abc");
+    assert(record.inlineBytes() == 1 + 8 + 1 + 2 + 3 && !record.overflowed());
+    std::string formatted;
+    record.format(formatted);
+    assert(formatted == "1abc");
+
+    // A Message too big for the inline Buffer is serialized once, straight into the Overflow
+    struct BigMessage : BLogBufferedMessage {
+        mutable int serialized = 0;
+        void serializeTo(std::string& buffer) const override {
+            serialized++;
+            buffer += std::string(200, 'm');
+        }
+    } big;
+    BDeferredRecord bigRecord;
+    bigRecord.push("x");
+    bigRecord.push(big);
+    bigRecord.push(2);
+    assert(big.serialized == 1 && bigRecord.overflowed());
+    formatted.clear();
+    bigRecord.format(formatted);
+    assert(formatted == "x" + std::string(200, 'm') + "2");
+
+    // Filtering happens on the Producer, the Topic comes from the Callsite
+    BLoggerConfig::setDefaultLogLevel(BLogLevel::WARNING);
+    BLOG_DEFERRED(async, "", BLogLevel::INFO) << "filtered";
+    BLoggerConfig::setTopics({"net"});
+    BLOG_DEFERRED(async, "disk", BLogLevel::ERROR) << "filtered topic";
+    BLOG_DEFERRED(async, "net", BLogLevel::ERROR) << "net error";
+    async->flushQueue();
+    assert(sink->output == "[ERROR] net error\n");
+    sink->output.clear();
+    BLoggerConfig::setTopics({});
+
+    // Many Producers
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 8; i++) {
+        threads.emplace_back([&async, i]() {
+            for(int j = 0; j < 500; j++) {
+                if(j % 2)
+                    BLOG_DEFERRED(async, "", BLogLevel::ERROR) << "thread " << i << " msg " << j;
+                else
+                    (*async)[BLogLevel::ERROR] << "thread " << i << " msg " << j;
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+    async->flushQueue();
+
+    size_t lines = 0;
+    for(char c : sink->output)
+        lines += (c == '\n');
+    assert(lines == 8 * 500);
+    assert(sink->output.find("[ERROR] thread 7 msg 499\n") != std::string::npos);
+    sink->output.clear();
+
+    // Destruction drains the Queue
+    {
+        auto scoped = BAsyncDecorator::decorate(sink);
+        for(int i = 0; i < 100; i++)
+            BLOG_DEFERRED(scoped, "", BLogLevel::ERROR) << i;
+    }
+    assert(sink->output.substr(0, 4) == "0\n1\n" && sink->output.find("99\n") != std::string::npos);
+
+    // Only works on an Async Decorator
+    try {
+        std::shared_ptr<BLogger> plain = sink;
+        BLOG_DEFERRED(plain, "", BLogLevel::ERROR) << "fails";
+        assert(false);
+    } catch(const std::runtime_error&) { }
+
+    // A throwing Sink neither ends the Writer nor the Process
+    auto throwing = std::make_shared<ThrowingLogger>("async_throwing");
+    auto guarded = BAsyncDecorator::decorate(throwing);
+    BLOG_DEFERRED(guarded, "", BLogLevel::ERROR) << "ok " << 1;
+    BLOG_DEFERRED(guarded, "", BLogLevel::ERROR) << "bad";
+    BLOG_DEFERRED(guarded, "", BLogLevel::ERROR) << "ok " << 2;
+    guarded->flushQueue();
+    assert(throwing->output == "ok 1\n\nok 2\n");
+    assert(guarded->failedRecords() == 1);
+
+    // flush() waits for the Queue before flushing the wrapped Logger, flushQueue() flushes it as well
+    auto flushed = std::make_shared<ThrowingLogger>("async_flushed");
+    auto flushing = BAsyncDecorator::decorate(flushed);
+    for(int i = 0; i < 100; i++)
+        BLOG_DEFERRED(flushing, "", BLogLevel::ERROR) << i;
+    flushing->flush();
+    assert(flushed->flushedAt == 100);
+    BLOG_DEFERRED(flushing, "", BLogLevel::ERROR) << "last";
+    flushing->flushQueue();
+    assert(flushed->flushedAt == 101);
+
+    // Bounded Queue: while the Writer is stuck in the Sink, Records beyond maxQueued are dropped
+    auto stuck = std::make_shared<ThrowingLogger>("async_stuck");
+    stuck->blockOnFirst = true;
+    BAsyncOptions bounded;
+    bounded.maxQueued = 4;
+    auto limited = BAsyncDecorator::decorate(stuck, bounded);
+    BLOG_DEFERRED(limited, "", BLogLevel::ERROR) << "first";
+    while(!stuck->blocked)
+        std::this_thread::yield();
+    for(int i = 0; i < 10; i++)
+        BLOG_DEFERRED(limited, "", BLogLevel::ERROR) << i;
+    stuck->release = true;
+    limited->flushQueue();
+    assert(limited->dropped() == 6);
+    assert(stuck->output == "first\n0\n1\n2\n3\n");
+}
+
+std::string readWholeFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+void testFdLogger() {
+    std::cout << "Test Fd Logger:\n";
+
+    const std::string path = logPath("03_fd_log");
+    std::remove(path.c_str());
+
+    // Owns its Descriptor, so it can neither be copied nor moved
+    static_assert(!std::is_copy_constructible<BFdLogger>::value && !std::is_copy_assignable<BFdLogger>::value);
+    static_assert(!std::is_move_constructible<BFdLogger>::value && !std::is_move_assignable<BFdLogger>::value);
+
+    // Undecorated: Fragments are collected and written with the Newline
+    {
+        auto fdLogger = std::make_shared<BFdLogger>("fd", path);
+        *fdLogger << "plain " << 1;
+        assert(readWholeFile(path) == "plain 1\n");
+
+        // Decorated: Prefixes and Body arrive as Segments
+        auto lg = BLoglevelDecorator::decorate(BLocationDecorator::decorate(fdLogger));
+        BLOG_AT(lg)[BLogLevel::WARNING] << "segmented";
+        std::string expected = "plain 1\n[" + std::string(__FILE__) + ":" + std::to_string(__LINE__ - 1) + "] [WARNING] segmented\n";
+        assert(readWholeFile(path) == expected);
+
+        // Custom Decorator without Prefix-Support still works (joined on the Way)
+        auto sanitized = BSanitizeDecorator::decorate(BLoglevelDecorator::decorate(fdLogger));
+        (*sanitized)[BLogLevel::INFO] << "two\nlines";
+        assert(readWholeFile(path) == expected + "[INFO] two\\nlines\n");
+    }
+
+    // Batched: nothing written until the Buffer is full or flushed
+    std::remove(path.c_str());
+    {
+        auto batched = std::make_shared<BFdLogger>("fd_batched", path, true, 64);
+        auto lg = BLoglevelDecorator::decorate(batched);
+        (*lg)[BLogLevel::INFO] << "first";
+        (*lg)[BLogLevel::INFO] << "second";
+        assert(readWholeFile(path).empty());
+        lg->flush();
+        assert(readWholeFile(path) == "[INFO] first\n[INFO] second\n");
+
+        (*lg)[BLogLevel::INFO] << std::string(100, 'x');     // Larger than the Batch, written right away
+        assert(readWholeFile(path) == "[INFO] first\n[INFO] second\n[INFO] " + std::string(100, 'x') + "\n");
+        (*lg)[BLogLevel::INFO] << "last";
+    }
+    assert(readWholeFile(path).substr(readWholeFile(path).size() - 12) == "[INFO] last\n");
+
+    // Several Loggers appending to the same File (like several Processes would): no torn Records
+    std::remove(path.c_str());
+    {
+        auto a = BLoglevelDecorator::decorate(std::make_shared<BFdLogger>("fd_a", path, true, 256));
+        auto b = BLoglevelDecorator::decorate(std::make_shared<BFdLogger>("fd_b", path, true));
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; t++) {
+            threads.emplace_back([&a, &b, t]() {
+                for(int i = 0; i < 250; i++)
+                    (*(t % 2 ? a : b))[BLogLevel::ERROR] << "writer " << t << " record " << i;
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+    }
+    std::istringstream lines(readWholeFile(path));
+    std::string line;
+    size_t count = 0;
+    while(std::getline(lines, line)) {
+        assert(line.rfind("[ERROR] writer ", 0) == 0);
+        count++;
+    }
+    assert(count == 1000);
+}
+
+// Counts its Serializations, to check that filtered Records are never formatted
+class CountingMessage : public BLogMessage {
+    public:
+        mutable int serialized = 0;
+
+        inline const std::string serialize() const override {
+            serialized++;
+            return "counted";
+        }
+};
+
+void testFormat() {
+    std::cout << "Test Format: \n";
+    ConfigRestore restore;
+
+    auto sink = std::make_shared<CaptureLogger>("format_capture");
+    auto lg = BLoglevelDecorator::decorate(sink);
+
+    BLOGF((*lg)[BLogLevel::INFO], "x={} y={}", 1, 2.5);
+    assert(sink->output == "[INFO] x=1 y=2.5\n");
+    assert(lg->getLastMessage() == "x=1 y=2.5");
+
+    // Typed Placeholders, Escapes and the Types the Chain supports
+    sink->output.clear();
+    BLOGF((*lg)[BLogLevel::WARNING], "{:d} {:x} {:f} {:s} {{{}}} {} {} {}", -42, 255u, 0.5, "str", std::string("braces"), true, 'c', HexBMsg(uint8_t(171)));
+    assert(sink->output == "[WARNING] -42 ff 0.500000 str {braces} 1 c 0xab\n");
+
+    // Same Output as the Chain for the untyped Placeholder
+    sink->output.clear();
+    double value = 3.14159265;
+    BLOGF((*lg)[BLogLevel::INFO], "{}", value);
+    (*lg)[BLogLevel::INFO] << value;
+    assert(sink->output == "[INFO] 3.14159\n[INFO] 3.14159\n");
+
+    sink->output.clear();
+    signed char sc = 'A';
+    unsigned char uc = 'z';
+    BLOGF((*lg)[BLogLevel::INFO], "{}{} {:d} {:x}", sc, uc, sc, uc);
+    (*lg)[BLogLevel::INFO] << sc << uc;
+    assert(sink->output == "[INFO] Az 65 7a\n[INFO] Az\n");
+
+    sink->output.clear();
+    BLOGF(lg, "no placeholders");
+    BLOGF(lg, "");                      // Empty Line, same as *lg << ""
+    assert(sink->output == "[NONE] no placeholders\n\n");
+
+    // Filters of BLoggerConfig apply, Arguments of filtered Records are not formatted
+    CountingMessage counting;
+    sink->output.clear();
+    BLoggerConfig::setDefaultLogLevel(BLogLevel::WARNING);
+    BLOGF((*lg)[BLogLevel::INFO], "{}", counting);
+    assert(counting.serialized == 0 && sink->output.empty());
+    BLOGF((*lg)[BLogLevel::ERROR], "{}", counting);
+    assert(counting.serialized == 1 && sink->output == "[ERROR] counted\n");
+    BLoggerConfig::setDefaultLogLevel(BLogLevel::NONE);
+
+    BLoggerConfig::setTopics({"database"});
+    BLOGF((*lg)("network")[BLogLevel::ERROR], "{}", counting);
+    BLOGF((*lg)[BLogLevel::ERROR] % false, "{}", counting);
+    assert(counting.serialized == 1);
+    BLOGF((*lg)("database")[BLogLevel::ERROR], "{}", counting);
+    assert(counting.serialized == 2);
+    BLoggerConfig::setTopics({});
+
+    // Filtered Records still reset Level and Topic like a Chain does
+    sink->output.clear();
+    BLOGF(lg, "reset");
+    assert(sink->output == "[NONE] reset\n");
+
+    // Works through a BLogContext as well
+    BLogContext context(lg, "", BLogLevel::ERROR);
+    sink->output.clear();
+    BLOGF(context.warning(), "{} of {}", 1, 2);
+    assert(sink->output == "[WARNING] 1 of 2\n");
+}
+
+// Everything currently readable from a non-blocking Descriptor
+std::string drainFd(int fd) {
+    std::string result;
+    char chunk[4096];
+    ssize_t got;
+    while((got = ::read(fd, chunk, sizeof(chunk))) > 0)
+        result.append(chunk, static_cast<size_t>(got));
+    return result;
+}
+
+void testConsoleLogger() {
+    std::cout << "Test Console Logger: \n";
+
+    int outPipe[2];
+    int errPipe[2];
+    assert(::pipe(outPipe) == 0 && ::pipe(errPipe) == 0);
+    ::fcntl(outPipe[0], F_SETFL, O_NONBLOCK);
+    ::fcntl(errPipe[0], F_SETFL, O_NONBLOCK);
+
+    // Pipe is no TTY: batched until flush() or an ERROR, no Colors by default
+    {
+        BConsoleOptions options;
+        options.outFd = outPipe[1];
+        options.errFd = errPipe[1];
+        auto console = std::make_shared<BConsoleLogger>("console_pipe", options);
+        assert(!console->isColored());
+        auto lg = BLoglevelDecorator::decorate(console);
+        (*lg)[BLogLevel::INFO] << "first " << 1;
+        (*lg)[BLogLevel::WARNING] << "second";
+        assert(drainFd(outPipe[0]).empty());
+        lg->flush();
+        assert(drainFd(outPipe[0]) == "[INFO] first 1\n[WARNING] second\n");
+
+        (*lg)[BLogLevel::INFO] << "batched";
+        (*lg)[BLogLevel::ERROR] << "written right away";
+        assert(drainFd(outPipe[0]) == "[INFO] batched\n[ERROR] written right away\n");
+
+        (*lg)[BLogLevel::DEBUG] << "on destruction";
+    }
+    assert(drainFd(outPipe[0]) == "[DEBUG] on destruction\n");
+
+    // Colors and WARNING+ to stderr, without Batching
+    {
+        BConsoleOptions options;
+        options.outFd = outPipe[1];
+        options.errFd = errPipe[1];
+        options.colors = BConsoleColors::ALWAYS;
+        options.errorsToStderr = true;
+        options.batchBytes = 0;
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<BConsoleLogger>("console_split", options));
+        (*lg)[BLogLevel::INFO] << "ok";
+        (*lg)[BLogLevel::LOG] << "plain";
+        (*lg)[BLogLevel::WARNING] << "careful";
+        (*lg)[BLogLevel::ERROR] << "broken";
+        assert(drainFd(outPipe[0]) == "\033[32m[INFO] ok\033[0m\n[LOG] plain\n");
+        assert(drainFd(errPipe[0]) == "\033[33m[WARNING] careful\033[0m\n\033[31m[ERROR] broken\033[0m\n");
+    }
+
+    // Order between the Streams is kept even when batching
+    {
+        BConsoleOptions options;
+        options.outFd = outPipe[1];
+        options.errFd = errPipe[1];
+        options.errorsToStderr = true;
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<BConsoleLogger>("console_order", options));
+        (*lg)[BLogLevel::INFO] << "before";
+        (*lg)[BLogLevel::WARNING] << "warned";
+        assert(drainFd(outPipe[0]) == "[INFO] before\n");
+        assert(drainFd(errPipe[0]).empty());
+    }
+    assert(drainFd(errPipe[0]) == "[WARNING] warned\n");
+
+    // A Batch is written by the Timer maxDelay after it started, even if nothing follows
+    {
+        BConsoleOptions options;
+        options.outFd = outPipe[1];
+        options.errFd = errPipe[1];
+        options.maxDelay = std::chrono::milliseconds(100);
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<BConsoleLogger>("console_delay", options));
+        (*lg)[BLogLevel::INFO] << "old";
+        (*lg)[BLogLevel::INFO] << "older";
+        assert(drainFd(outPipe[0]).empty());
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        assert(drainFd(outPipe[0]) == "[INFO] old\n[INFO] older\n");
+        (*lg)[BLogLevel::INFO] << "young";
+        assert(drainFd(outPipe[0]).empty());
+    }
+    assert(drainFd(outPipe[0]) == "[INFO] young\n");
+
+    for(int fd : {outPipe[0], outPipe[1], errPipe[0], errPipe[1]})
+        ::close(fd);
+
+    // On a TTY every Record is written right away, colored by default
+    int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if(master >= 0 && ::grantpt(master) == 0 && ::unlockpt(master) == 0) {
+        int slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+        assert(slave >= 0);
+        ::fcntl(master, F_SETFL, O_NONBLOCK);
+        {
+            BConsoleOptions options;
+            options.outFd = slave;
+            auto console = std::make_shared<BConsoleLogger>("console_tty", options);
+            assert(console->isColored() == (std::getenv("NO_COLOR") == nullptr));
+            *console << "tty record";
+            std::string written = drainFd(master);
+            assert(written.find("tty record") != std::string::npos);
+        }
+        ::close(slave);
+    }
+    if(master >= 0)
+        ::close(master);
+}
+
+void testRepeat() {
+    std::cout << "Test Repeat: \n";
+
+    auto sink = std::make_shared<CaptureLogger>("repeat_capture");
+    auto repeat = BRepeatDecorator::decorate(BLoglevelDecorator::decorate(sink), std::chrono::hours(1));
+
+    for(int i = 0; i < 5; i++)
+        (*repeat)[BLogLevel::WARNING] << "retrying " << "connect";
+    assert(sink->output == "[WARNING] retrying connect\n");
+
+    // Summary comes before the next different Record, with the Level of the repeated one
+    (*repeat)[BLogLevel::INFO] << "connected";
+    assert(sink->output == "[WARNING] retrying connect\n[WARNING] last message repeated 4 times\n[INFO] connected\n");
+
+    // Same Text with a different Level or Topic is no Repetition
+    sink->output.clear();
+    (*repeat)[BLogLevel::ERROR] << "connected";
+    (*repeat)("net")[BLogLevel::ERROR] << "connected";
+    (*repeat)("net")[BLogLevel::ERROR] << "connected";
+    assert(sink->output == "[ERROR] connected\n[ERROR] connected\n");
+
+    // flush() writes the pending Summary
+    repeat->flush();
+    assert(sink->output == "[ERROR] connected\n[ERROR] connected\n[ERROR] last message repeated 1 time\n");
+
+    // Records from a Decorator above arrive as Segments and are compared the same Way
+    sink->output.clear();
+    auto located = BLocationDecorator::decorate(repeat);
+    for(int i = 0; i < 3; i++)
+        BLOG_AT(located)[BLogLevel::INFO] << "same call site";
+    BLOG_AT(located)[BLogLevel::INFO] << "same call site";
+    std::string site = std::string(__FILE__) + ":";
+    std::istringstream lines(sink->output);
+    std::string line;
+    std::vector<std::string> all;
+    while(std::getline(lines, line))
+        all.push_back(line);
+    assert(all.size() == 3);
+    assert(all[1] == "[INFO] last message repeated 2 times");
+    assert(all[0].find(site) != std::string::npos && all[0] != all[2]);
+
+    // Every Topic keeps its own last Record, interleaved Repetitions collapse each on their own
+    sink->output.clear();
+    for(int i = 0; i < 3; i++) {
+        (*repeat)("network")[BLogLevel::WARNING] << "retrying";
+        (*repeat)("health")[BLogLevel::INFO] << "alive";
+    }
+    assert(sink->output == "[WARNING] retrying\n[INFO] alive\n");
+    (*repeat)("network")[BLogLevel::INFO] << "connected";
+    assert(sink->output == "[WARNING] retrying\n[INFO] alive\n[WARNING] last message repeated 2 times\n[INFO] connected\n");
+    repeat->flush();
+    assert(sink->output.find("[INFO] connected\n[INFO] last message repeated 2 times\n") != std::string::npos);
+
+    // At most maxTopics are tracked, the Topic seen longest ago is dropped (with its Summary) first
+    sink->output.clear();
+    {
+        auto bounded = BRepeatDecorator::decorate(BLoglevelDecorator::decorate(sink), std::chrono::hours(1), 2);
+        (*bounded)("a")[BLogLevel::INFO] << "x";
+        (*bounded)("a")[BLogLevel::INFO] << "x";
+        (*bounded)("b")[BLogLevel::INFO] << "y";
+        (*bounded)("c")[BLogLevel::INFO] << "z";
+        assert(sink->output == "[INFO] x\n[INFO] y\n[INFO] last message repeated 1 time\n[INFO] z\n");
+        (*bounded)("a")[BLogLevel::INFO] << "x";                   // "a" was dropped -> no Repetition any more
+        assert(sink->output == "[INFO] x\n[INFO] y\n[INFO] last message repeated 1 time\n[INFO] z\n[INFO] x\n");
+    }
+
+    // Timeout: a Summary every Window while the Duplicates keep coming
+    auto sink2 = std::make_shared<CaptureLogger>("repeat_timeout_capture");
+    {
+        auto timed = BRepeatDecorator::decorate(sink2, std::chrono::milliseconds(0));
+        *timed << "spin";
+        *timed << "spin";
+        *timed << "spin";
+        assert(sink2->output == "spin\nlast message repeated 1 time\nlast message repeated 1 time\n");
+
+        // Pending Repetitions are written on Destruction
+        auto slow = BRepeatDecorator::decorate(sink2, std::chrono::hours(1));
+        sink2->output.clear();
+        *slow << "bye";
+        *slow << "bye";
+    }
+    assert(sink2->output == "bye\nlast message repeated 1 time\n");
+
+    // A Burst that just stops still gets its Summary from the Timer, once the Window (started with the first Record) is over
+    sink2->output.clear();
+    {
+        auto timed = BRepeatDecorator::decorate(sink2, std::chrono::milliseconds(20));
+        (*timed)[BLogLevel::WARNING] << "burst";
+        (*timed)[BLogLevel::WARNING] << "burst";
+        (*timed)[BLogLevel::WARNING] << "burst";
+        assert(sink2->output == "burst\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        sink2->flush();                         // Only to synchronize with the Timer-Thread
+        assert(sink2->output == "burst\nlast message repeated 2 times\n");
+    }
+    assert(sink2->output == "burst\nlast message repeated 2 times\n");
+}
+
+void testSpan() {
+    std::cout << "Test Span: \n";
+    ConfigRestore restore;
+
+    auto lg = std::make_shared<CaptureLogger>("span_capture");
+    BLogTrace::clear();
+
+    {
+        BLogSpan outer(lg, "outer \"request\"", "network");
+        {
+            BLogSpan inner(lg, "inner", "network", BLogLevel::DEBUG);
+        }
+        BLogSpan early(lg, "ended early");
+        early.end();
+        assert(!early.isActive());
+    }
+
+    auto events = BLogTrace::collect();
+    assert(events.size() == 3);
+    // Ordered by End per Thread
+    assert(events[0].name == "inner" && events[0].depth == 1 && events[0].level == BLogLevel::DEBUG);
+    assert(events[1].name == "ended early" && events[1].depth == 1 && events[1].topic.empty());
+    assert(events[2].name == "outer \"request\"" && events[2].depth == 0 && events[2].topic == "network");
+    assert(events[0].tid == events[2].tid);
+    // Inner lies within outer
+    assert(events[0].beginNs >= events[2].beginNs);
+    assert(events[0].beginNs + events[0].durationNs <= events[2].beginNs + events[2].durationNs);
+    assert(lg->output.empty());
+
+    // Filters of BLoggerConfig apply
+    BLoggerConfig::setDefaultLogLevel(BLogLevel::INFO);
+    BLoggerConfig::setTopics({"database"});
+    {
+        BLogSpan debug(lg, "too verbose", "database", BLogLevel::DEBUG);
+        BLogSpan otherTopic(lg, "wrong topic", "network");
+        BLogSpan enabled(lg, "query", "database", BLogLevel::WARNING);
+        assert(!debug.isActive() && !otherTopic.isActive() && enabled.isActive());
+    }
+    BLoggerConfig::setTopics({});
+    BLoggerConfig::setDefaultLogLevel(BLogLevel::NONE);
+    events = BLogTrace::collect();
+    assert(events.size() == 4 && events[3].name == "query" && events[3].depth == 0);
+
+    // Every Thread has its own Buffer, still exported after the Thread ended
+    std::thread worker([&lg]() {
+        BLogSpan span(lg, "worker");
+    });
+    worker.join();
+    events = BLogTrace::collect();
+    assert(events.size() == 5);
+    uint32_t workerTid = 0;
+    for(const auto& event : events) {
+        if(event.name == "worker")
+            workerTid = event.tid;
+    }
+    assert(workerTid != 0 && workerTid != events[0].tid);
+
+    std::string json = BLogTrace::toJson();
+    assert(json.rfind("{\"traceEvents\":[", 0) == 0);
+    assert(json.find("\"name\":\"outer \\\"request\\\"\",\"cat\":\"network\",\"ph\":\"X\",\"ts\":") != std::string::npos);
+    assert(json.find("\"cat\":\"default\"") != std::string::npos);
+    assert(json.find("\"args\":{\"level\":\"WARNING\",\"depth\":0}") != std::string::npos);
+    assert(json.find("\"tid\":" + std::to_string(workerTid)) != std::string::npos);
+
+    const std::string tracePath = logPath("07_trace.json");
+    BLogTrace::writeJson(tracePath);
+    assert(readWholeFile(tracePath) == json);
+
+    BLogTrace::clear();
+    assert(BLogTrace::collect().empty());
+
+    // Buffers are bounded, Spans ending on a full one are only counted
+    BLogTrace::setCapacity(2);
+    for(int i = 0; i < 3; i++)
+        BLogSpan span(lg, "bounded");
+    assert(BLogTrace::collect().size() == 2 && BLogTrace::dropped() == 1);
+    BLogTrace::setCapacity(BLogTrace::DEFAULT_CAPACITY);
+
+    // drain() takes the Events out and frees the Buffers of finished Threads
+    std::thread finished([&lg]() {
+        BLogSpan span(lg, "finished thread");
+    });
+    finished.join();
+    size_t buffers = BLogTrace::threadBuffers();
+    events = BLogTrace::drain();
+    assert(events.size() == 3 && events[2].name == "finished thread");
+    assert(BLogTrace::collect().empty());
+    assert(BLogTrace::threadBuffers() == buffers - 1);
+
+    bool threw = false;
+    try {
+        BLogTrace::setCapacity(0);
+    } catch(const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    BLogTrace::clear();
+    assert(BLogTrace::dropped() == 0);
+}
+
+// Deterministic Payload per Writer and Record, long enough to span several Slots now and then
+std::string shmPayload(int writer, int record) {
+    return std::string(static_cast<size_t>((record * 37 + writer * 11) % 300), static_cast<char>('a' + (record + writer) % 26));
+}
+
+void testShmRing() {
+    std::cout << "Test Shared Memory Ring: \n";
+
+    const std::string ringName = "/blogger_test_" + std::to_string(::getpid());
+    const std::string path = logPath("08_shm_log");
+    constexpr int WRITERS = 4;
+    constexpr int RECORDS = 2000;
+    constexpr size_t MAX_FILE_BYTES = 64 * 1024;
+    constexpr size_t KEEP_FILES = 100;
+
+    BShmRing::remove(ringName);
+    std::remove(path.c_str());
+    for(size_t i = 1; i < KEEP_FILES; i++)
+        std::remove((path + "." + std::to_string(i)).c_str());
+
+    {
+        // Small Ring, so the Writers wrap around and have to wait for the Collector a lot
+        BShmRing ring(ringName, 64, 128);
+        BShmCollector collector({ringName}, path, MAX_FILE_BYTES, KEEP_FILES);
+
+        std::vector<pid_t> children;
+        for(int w = 0; w < WRITERS; w++) {
+            pid_t pid = ::fork();
+            assert(pid >= 0);
+            if(pid == 0) {
+                auto lg = BLoglevelDecorator::decorate(std::make_shared<BShmLogger>("shm_writer", ringName,
+                    BShmRing::Overflow::BLOCK, 64, 128, std::chrono::seconds(30)));
+                for(int i = 0; i < RECORDS; i++)
+                    (*lg)[BLogLevel::INFO] << "writer " << w << " record " << i << " " << shmPayload(w, i);
+                ::_exit(0);
+            }
+            children.push_back(pid);
+        }
+
+        size_t running = children.size();
+        while(running > 0) {
+            collector.drainFor(std::chrono::milliseconds(10));
+            for(auto& child : children) {
+                int status;
+                if(child > 0 && ::waitpid(child, &status, WNOHANG) == child) {
+                    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+                    child = 0;
+                    running--;
+                }
+            }
+        }
+        collector.drain();
+        assert(ring.dropped() == 0);
+    }
+
+    // Oldest File first
+    std::vector<std::string> files;
+    for(size_t i = KEEP_FILES - 1; i > 0; i--) {
+        std::ifstream probe(path + "." + std::to_string(i));
+        if(probe)
+            files.push_back(path + "." + std::to_string(i));
+    }
+    files.push_back(path);
+    assert(files.size() > 2);
+
+    int next[WRITERS] = {0};
+    for(const auto& file : files) {
+        std::string content = readWholeFile(file);
+        assert(content.size() <= MAX_FILE_BYTES);
+        assert(!content.empty() && content.back() == '\n');
+
+        std::istringstream lines(content);
+        std::string line;
+        while(std::getline(lines, line)) {
+            int w;
+            int i;
+            char payload[512] = {0};
+            int matched = std::sscanf(line.c_str(), "[INFO] writer %d record %d %511s", &w, &i, payload);
+            assert(matched >= 2 && w >= 0 && w < WRITERS);
+            // Every Record of a Writer exactly once, in Order, and not torn
+            assert(i == next[w]);
+            assert(line == "[INFO] writer " + std::to_string(w) + " record " + std::to_string(i) + " " + shmPayload(w, i));
+            next[w]++;
+        }
+        std::remove(file.c_str());
+    }
+    for(int w = 0; w < WRITERS; w++)
+        assert(next[w] == RECORDS);
+    BShmRing::remove(ringName);
+
+    // Overflow::DROP: nothing blocks, dropped Records are counted
+    {
+        const std::string dropName = ringName + "_drop";
+        BShmRing::remove(dropName);
+        BShmRing ring(dropName, 4, 64);
+        auto lg = std::make_shared<BShmLogger>("shm_drop", dropName, BShmRing::Overflow::DROP);
+        for(int i = 0; i < 20; i++)
+            *lg << "record " << i;
+
+        std::string record;
+        size_t consumed = 0;
+        while(ring.consume(record))
+            consumed++;
+        assert(consumed == 4 && lg->dropped() == 16);
+        assert(record == "record 0record 1record 2record 3");
+
+        // Longer than the whole Ring: truncated, never torn
+        *lg << std::string(1000, 'x');
+        record.clear();
+        assert(ring.consume(record) && record == std::string(ring.maxRecordBytes(), 'x'));
+        BShmRing::remove(dropName);
+    }
+
+    // Overflow::BLOCK without a Collector gives up after the Timeout instead of hanging
+    {
+        const std::string blockName = ringName + "_block";
+        BShmRing::remove(blockName);
+        BShmRing ring(blockName, 4, 64);
+        auto lg = std::make_shared<BShmLogger>("shm_block", blockName, BShmRing::Overflow::BLOCK, 4, 64, std::chrono::milliseconds(20));
+        for(int i = 0; i < 6; i++)
+            *lg << "record " << i;
+        assert(lg->dropped() == 2);
+        BShmRing::remove(blockName);
+    }
+}
+
+void testLogIndex() {
+    std::cout << "Test Log Index: \n";
+
+    const std::string path = logPath("09_indexed_log");
+    std::remove(path.c_str());
+    std::remove((path + ".idx").c_str());
+
+    BLogIndexOptions options;
+    options.blockBytes = 256;
+    options.bucketMs = 60 * 60 * 1000;
+    int64_t before = BLogIndex::nowMs();
+    {
+        auto lg = BLoglevelDecorator::decorate(std::make_shared<BFileLogger>("indexed_file", path, options));
+        for(int i = 0; i < 400; i++) {
+            // Rare Errors in network, the rest is noise
+            if(i % 97 == 13)
+                (*lg)("network")[BLogLevel::ERROR] << "network failure " << i;
+            else if(i % 5 == 0)
+                (*lg)("database")[BLogLevel::WARNING] << "database failure " << i;
+            else
+                (*lg)(i % 2 ? "network" : "database")[BLogLevel::INFO] << "noise " << i;
+        }
+    }
+    int64_t after = BLogIndex::nowMs();
+
+    std::string content = readWholeFile(path);
+    BLogIndexReader index(path + ".idx");
+    assert(index.size() > 10);
+
+    // Blocks cover the whole File, without Gaps
+    uint64_t expectedOffset = 0;
+    uint32_t records = 0;
+    for(size_t i = 0; i < index.size(); i++) {
+        assert(index[i].offset == expectedOffset);
+        assert(index[i].firstMs >= before && index[i].lastMs <= after);
+        expectedOffset += index[i].length;
+        records += index[i].records;
+    }
+    assert(expectedOffset == content.size() && records == 400);
+
+    auto collect = [&content](const std::vector<std::pair<uint64_t, uint64_t>>& ranges) {
+        std::string selected;
+        for(const auto& [offset, length] : ranges) {
+            // Ranges start and end on Record-Boundaries
+            assert(offset == 0 || content[offset - 1] == '\n');
+            assert(content[offset + length - 1] == '\n');
+            selected += content.substr(offset, length);
+        }
+        return selected;
+    };
+
+    BLogIndexQuery query;
+    query.levels = BLogIndex::levelBit(BLogLevel::ERROR);
+    query.topics = BLogIndex::topicBit("network");
+    std::string selected = collect(index.query(query));
+    for(int i = 13; i < 400; i += 97)
+        assert(selected.find("[ERROR] network failure " + std::to_string(i) + "\n") != std::string::npos);
+    assert(selected.size() < content.size() / 2);
+
+    // Everything
+    assert(collect(index.query(BLogIndexQuery())) == content);
+
+    // Level that never occurred, Time-Range before and after the Log
+    query = BLogIndexQuery();
+    query.levels = BLogIndex::levelBit(BLogLevel::DEBUG);
+    assert(index.query(query).empty());
+    query = BLogIndexQuery();
+    query.toMs = before - 1;
+    assert(index.query(query).empty());
+    query = BLogIndexQuery();
+    query.fromMs = after + 1;
+    assert(index.query(query).empty());
+
+    // Reopening appends to File and Index, Offsets continue
+    {
+        auto lg = std::make_shared<BFileLogger>("indexed_file_reopened", path, options);
+        (*lg)("network")[BLogLevel::WARNING] << "after reopen";
+        lg->flush();
+        BLogIndexReader reopened(path + ".idx");
+        assert(reopened.size() == index.size() + 1);
+        const BLogIndexBlock& last = reopened[reopened.size() - 1];
+        assert(last.offset == content.size() && last.records == 1);
+        assert(readWholeFile(path).substr(last.offset, last.length) == "after reopen\n");
+    }
+
+    // The open Block is visible without flush(), right when it starts and with every Record at syncMs 0
+    const std::string livePath = logPath("09_indexed_live_log");
+    std::remove(livePath.c_str());
+    std::remove((livePath + ".idx").c_str());
+    {
+        BLogIndexOptions liveOptions;
+        liveOptions.syncMs = 0;
+        auto lg = std::make_shared<BFileLogger>("indexed_file_live", livePath, liveOptions);
+        (*lg)("network")[BLogLevel::ERROR] << "first";
+        (*lg)("network")[BLogLevel::INFO] << "second";
+        BLogIndexReader live(livePath + ".idx");
+        assert(live.size() == 1 && live[0].records == 2 && live.indexedEnd() == readWholeFile(livePath).size());
+    }
+    BLogIndexReader live(livePath + ".idx");
+    assert(live.size() == 1 && live[0].records == 2);
+
+    // Wall-Clock stepping back: Times are kept monotonic, also across a Reopen
+    const std::string clockPath = logPath("09_index_clock.idx");
+    std::remove(clockPath.c_str());
+    {
+        BLogIndexWriter writer(clockPath, BLogIndexOptions());
+        writer.add(0, 10, BLogLevel::INFO, "", 5000);
+        writer.add(10, 20, BLogLevel::INFO, "", 3000);
+    }
+    {
+        BLogIndexWriter writer(clockPath, BLogIndexOptions());
+        writer.add(20, 30, BLogLevel::INFO, "", 4000);
+        writer.add(30, 40, BLogLevel::INFO, "", 7000);
+    }
+    {
+        BLogIndexReader clock(clockPath);
+        assert(clock.size() == 3);
+        assert(clock[0].firstMs == 5000 && clock[0].lastMs == 5000 && clock[0].records == 2);
+        assert(clock[1].firstMs == 5000 && clock[1].lastMs == 5000);
+        assert(clock[2].firstMs == 7000);
+        BLogIndexQuery late;
+        late.fromMs = 6000;
+        assert(clock.query(late) == (std::vector<std::pair<uint64_t, uint64_t>>{{30, 10}}));
+    }
+
+    // Arguments of blogquery
+    BLogLevel parsedLevel = BLogLevel::NONE;
+    assert(BLogQueryArgs::parseLevel("WARNING", parsedLevel) && parsedLevel == BLogLevel::WARNING);
+    assert(!BLogQueryArgs::parseLevel("warning", parsedLevel) && parsedLevel == BLogLevel::WARNING);
+
+    std::tm day{};
+    day.tm_year = 2024 - 1900;
+    day.tm_mon = 2;
+    day.tm_mday = 5;
+    day.tm_hour = 10;
+    day.tm_min = 5;
+    day.tm_isdst = -1;
+    int64_t tenOFive = static_cast<int64_t>(std::mktime(&day)) * 1000;
+    int64_t reference = tenOFive + 3 * 60 * 60 * 1000 + 1234;          // Same Day, 13:05:01.234
+
+    assert(BLogQueryArgs::parseTime("1700000000", reference) == 1700000000000);
+    assert(BLogQueryArgs::parseTime("2024-03-05 10:05", reference) == tenOFive);
+    assert(BLogQueryArgs::parseTime("2024-03-05 10:05:30", reference) == tenOFive + 30000);
+    assert(BLogQueryArgs::parseTime("10:05", reference) == tenOFive);
+    assert(BLogQueryArgs::parseTime("10:05:30", reference) == tenOFive + 30000);
+    assert(BLogQueryArgs::parseTime("", reference) == -1);
+    assert(BLogQueryArgs::parseTime("yesterday", reference) == -1);
+    assert(BLogQueryArgs::parseTime("10:05 pm", reference) == -1);
+
+    // --to given to the Minute includes all of that Minute, given to the Second only that Second
+    assert(BLogQueryArgs::parseEnd("10:05", reference) == tenOFive + 59999);
+    assert(BLogQueryArgs::parseEnd("2024-03-05 10:05", reference) == tenOFive + 59999);
+    assert(BLogQueryArgs::parseEnd("10:05:30", reference) == tenOFive + 30000);
+    assert(BLogQueryArgs::parseEnd("1700000000", reference) == 1700000000000);
+    assert(BLogQueryArgs::parseEnd("later", reference) == -1);
+}
+
+std::string readFrames(const std::string& path, bool* broken = nullptr) {
+    BLogFrameReader reader(path);
+    std::string all;
+    while(reader.next(all)) {}
+    if(broken)
+        *broken = reader.isBroken();
+    return all;
+}
+
+void testCompressedFile() {
+    std::cout << "Test Compressed File: \n";
+
+    // Built-in Codec round trips (empty, tiny, Runs, incompressible, Log-like)
+    BLogLzCodec lz;
+    std::string random;
+    uint32_t state = 12345;
+    for(int i = 0; i < 5000; i++) {
+        state = state * 1664525u + 1013904223u;
+        random += static_cast<char>(state >> 24);
+    }
+    std::string logLike;
+    for(int i = 0; i < 500; i++)
+        logLike += "[2024-01-01 10:02:0" + std::to_string(i % 10) + "] [INFO] request " + std::to_string(i) + " done\n";
+    for(const std::string& input : {std::string(), std::string("a"), std::string("abcd"), std::string(100000, 'x'), random, logLike}) {
+        std::string packed;
+        lz.compress(input.data(), input.size(), packed);
+        std::string unpacked = "keep";
+        assert(lz.decompress(packed.data(), packed.size(), input.size(), unpacked));
+        assert(unpacked == "keep" + input);
+        // Damaged Input is rejected, not read out of Bounds
+        if(packed.size() > 2) {
+            std::string cut;
+            assert(!lz.decompress(packed.data(), packed.size() / 2, input.size(), cut) && cut.empty());
+        }
+    }
+    std::string packed;
+    lz.compress(logLike.data(), logLike.size(), packed);
+    assert(packed.size() < logLike.size() / 3);
+
+    const std::string path = logPath("10_compressed_log");
+    std::remove(path.c_str());
+
+    std::string expected;
+    {
+        BCompressOptions options;
+        options.blockBytes = 4096;
+        options.window = std::chrono::hours(1);
+        auto file = std::make_shared<BCompressedFileLogger>("compressed_file", path, options);
+        auto lg = BLoglevelDecorator::decorate(file);
+        for(int i = 0; i < 2000; i++) {
+            (*lg)[BLogLevel::INFO] << "request " << i << " handled by worker-" << i % 4;
+            expected += "[INFO] request " + std::to_string(i) + " handled by worker-" + std::to_string(i % 4) + "\n";
+        }
+        *file << "undecorated";
+        expected += "undecorated\n";
+
+        // flush() waits until every Block is on Disk
+        lg->flush();
+        bool broken = true;
+        assert(readFrames(path, &broken) == expected && !broken);
+    }
+    assert(readWholeFile(path).size() < expected.size() / 3);
+
+    // Crashed Writer: a torn last Frame is skipped, everything before it is readable
+    std::string content = readWholeFile(path);
+    {
+        std::ofstream torn(path, std::ios::binary | std::ios::trunc);
+        torn << content.substr(0, content.size() - 10);
+    }
+    bool broken = false;
+    std::string partial = readFrames(path, &broken);
+    assert(broken && !partial.empty() && partial.size() < expected.size());
+    assert(expected.compare(0, partial.size(), partial) == 0);
+
+    // Damaged Payload fails the Checksum
+    content[sizeof(BLogFrameHeader) + 5] ^= 0x55;
+    {
+        std::ofstream damaged(path, std::ios::binary | std::ios::trunc);
+        damaged << content;
+    }
+    assert(readFrames(path, &broken).empty() && broken);
+    content[sizeof(BLogFrameHeader) + 5] ^= 0x55;
+
+    // Damaged Sizes in the Header are a broken Frame, not a huge Allocation
+    for(size_t field : {offsetof(BLogFrameHeader, rawSize), offsetof(BLogFrameHeader, compressedSize)}) {
+        std::string damagedHeader = content;
+        uint32_t huge = 0xFFFFFFF0u;
+        std::memcpy(&damagedHeader[field], &huge, sizeof(huge));
+        {
+            std::ofstream damaged(path, std::ios::binary | std::ios::trunc);
+            damaged << damagedHeader;
+        }
+        broken = false;
+        assert(readFrames(path, &broken).empty() && broken);
+    }
+
+    // Time-Window: a Block is written without flush() once it is old enough
+    std::remove(path.c_str());
+    {
+        BCompressOptions options;
+        options.window = std::chrono::milliseconds(20);
+        auto file = std::make_shared<BCompressedFileLogger>("compressed_window", path, options, std::make_unique<BLogStoredCodec>());
+        *file << "waiting for the window";
+        for(int i = 0; i < 100 && readWholeFile(path).empty(); i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(readFrames(path) == "waiting for the window\n");
+        *file << "written on destruction";
+    }
+    assert(readFrames(path) == "waiting for the window\nwritten on destruction\n");
+}
+
+void testAsyncPool() {
+    std::cout << "Test Async Writer Pool:\n";
+
+    // cpulist Format of /sys/devices/system/node/node*/cpulist
+    assert(BLogNuma::parseCpuList("0-3,8-11") == (std::vector<int>{0, 1, 2, 3, 8, 9, 10, 11}));
+    assert(BLogNuma::parseCpuList("5") == (std::vector<int>{5}));
+    assert(BLogNuma::parseCpuList("").empty());
+    assert(BLogNuma::parseCpuList("0-1,,3") == (std::vector<int>{0, 1, 3}));
+    assert(BLogNuma::parseCpuList("x,2") == (std::vector<int>{2}));
+
+    // Node-IDs with a Gap and a Node without CPUs
+    BLogNuma gaps = BLogNuma::fromCpuLists({{0, "0-1"}, {2, "2-3,6"}, {3, ""}});
+    assert(gaps.nodeCount() == 4);
+    assert(gaps.nodeOf(1) == 0 && gaps.nodeOf(2) == 2 && gaps.nodeOf(6) == 2);
+    assert(gaps.nodeOf(5) == 0 && gaps.nodeOf(64) == 0 && gaps.nodeOf(-1) == 0);
+    assert(BLogNuma::fromCpuLists({}).nodeCount() == 1);
+
+    const BLogNuma& numa = BLogNuma::instance();
+    assert(numa.nodeCount() >= 1);
+    int node = numa.currentNode();
+    assert(node >= 0 && node < numa.nodeCount());
+    auto allowed = BLogNuma::allowedCpus();
+    assert(std::find(allowed.begin(), allowed.end(), sched_getcpu()) != allowed.end());
+
+    // Four pinned Writers, all on the CPU we run on right now (that one is allowed for sure)
+    int cpu = sched_getcpu();
+    auto sink = std::make_shared<CaptureLogger>("pool_capture");
+    BAsyncOptions options;
+    options.writers = 4;
+    options.cpus.assign(4, cpu);
+    auto pool = BAsyncDecorator::decorate(BLoglevelDecorator::decorate(sink), options);
+    assert(pool->writerCount() == 4);
+    assert(pool->pinnedWriters() == 4);
+
+    // Every Thread keeps its Order, nothing gets lost
+    constexpr int THREADS = 6;
+    constexpr int RECORDS = 300;
+    std::vector<std::thread> threads;
+    for(int i = 0; i < THREADS; i++) {
+        threads.emplace_back([&pool, i]() {
+            for(int j = 0; j < RECORDS; j++) {
+                if(j % 2)
+                    BLOG_DEFERRED(pool, "", BLogLevel::ERROR) << "t" << i << " " << j;
+                else
+                    (*pool)[BLogLevel::ERROR] << "t" << i << " " << j;
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+    pool->flushQueue();
+
+    std::vector<int> next(THREADS, 0);
+    std::istringstream lines(sink->output);
+    std::string line;
+    size_t count = 0;
+    while(std::getline(lines, line)) {
+        int thread = 0, record = 0;
+        assert(std::sscanf(line.c_str(), "[ERROR] t%d %d", &thread, &record) == 2);
+        assert(record == next[thread]);
+        next[thread]++;
+        count++;
+    }
+    assert(count == THREADS * RECORDS);
+    sink->output.clear();
+
+    // Unpinned Writers, destruction drains every Lane
+    {
+        BAsyncOptions unpinned;
+        unpinned.writers = 3;
+        auto scoped = BAsyncDecorator::decorate(sink, unpinned);
+        assert(scoped->pinnedWriters() == 0);
+        for(int i = 0; i < 100; i++)
+            BLOG_DEFERRED(scoped, "", BLogLevel::ERROR) << i;
+    }
+    assert(sink->output.substr(0, 4) == "0\n1\n" && sink->output.find("99\n") != std::string::npos);
+    sink->output.clear();
+
+    // A Writer that can't be pinned (CPU outside of the allowed Set) still writes, it only belongs to no Node
+    {
+        BAsyncOptions partly;
+        partly.writers = 2;
+        partly.cpus = {cpu, CPU_SETSIZE - 1};
+        auto scoped = BAsyncDecorator::decorate(sink, partly);
+        assert(scoped->pinnedWriters() == 1);
+        std::vector<std::thread> producers;
+        for(int i = 0; i < 4; i++) {
+            producers.emplace_back([&scoped]() {
+                BLOG_DEFERRED(scoped, "", BLogLevel::ERROR) << "from producer";
+            });
+        }
+        for(auto& producer : producers)
+            producer.join();
+        scoped->flushQueue();
+    }
+    assert(sink->output == "from producer\nfrom producer\nfrom producer\nfrom producer\n");
+
+    // Broken Options
+    BAsyncOptions noWriters;
+    noWriters.writers = 0;
+    BAsyncOptions wrongCpus;
+    wrongCpus.writers = 2;
+    wrongCpus.cpus = {0};
+    for(const auto& broken : {noWriters, wrongCpus}) {
+        try {
+            BAsyncDecorator::decorate(sink, broken);
+            assert(false);
+        } catch(const std::invalid_argument&) { }
+    }
+}
+
 #endif
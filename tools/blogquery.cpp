@@ -0,0 +1,130 @@
+// Query a Log written by BFileLogger with a Sidecar Index (<logfile>.idx) without scanning all of it.
+//
+//   blogquery <logfile> [--level LEVEL]... [--min-level LEVEL] [--topic TOPIC]... [--from TIME] [--to TIME] [--stats]
+//
+// TIME is either Seconds since the Epoch, "YYYY-MM-DD HH:MM[:SS]" or "HH:MM[:SS]" (local Time, on the Day of the
+// newest Record in the Index). Prints every Block that may contain a matching Record and the unindexed Tail of the
+// Log (Records the Index has not caught up with, e.g. after a Crash), so the Output can still be piped into grep
+// for the exact Lines:
+//
+//   blogquery ./log/app.log --level ERROR --topic network --from 10:02 --to 10:05 | grep ERROR
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../include/logger/blogIndex.hpp"
+#include "blogquery.hpp"
+
+static int usage() {
+    std::cerr << "Usage: blogquery <logfile> [--level LEVEL]... [--min-level LEVEL] [--topic TOPIC]...\n"
+              << "                 [--from TIME] [--to TIME] [--stats]\n"
+              << "TIME: seconds since epoch, \"YYYY-MM-DD HH:MM[:SS]\" or \"HH:MM[:SS]\"\n";
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    if(argc < 2)
+        return usage();
+
+    auto started = std::chrono::steady_clock::now();
+    const std::string logPath = argv[1];
+    BLogIndexQuery query;
+    std::string from;
+    std::string to;
+    uint32_t levels = 0;
+    bool stats = false;
+
+    for(int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        BLogLevel level;
+        if(option == "--stats") {
+            stats = true;
+        } else if(option == "--level" && hasValue && BLogQueryArgs::parseLevel(argv[i + 1], level)) {
+            levels |= BLogIndex::levelBit(level);
+            i++;
+        } else if(option == "--min-level" && hasValue && BLogQueryArgs::parseLevel(argv[i + 1], level)) {
+            for(int l = static_cast<int>(level); l <= static_cast<int>(BLogLevel::ERROR); l++)
+                levels |= BLogIndex::levelBit(static_cast<BLogLevel>(l));
+            i++;
+        } else if(option == "--topic" && hasValue) {
+            query.topics |= BLogIndex::topicBit(argv[++i]);
+        } else if(option == "--from" && hasValue) {
+            from = argv[++i];
+        } else if(option == "--to" && hasValue) {
+            to = argv[++i];
+        } else {
+            std::cerr << "Unknown or incomplete option: " << option << "\n";
+            return usage();
+        }
+    }
+    if(levels != 0)
+        query.levels = levels;
+
+    try {
+        BLogIndexReader index(logPath + ".idx");
+        int64_t newestMs = index.size() > 0 ? index[index.size() - 1].lastMs : BLogIndex::nowMs();
+        if(!from.empty() && (query.fromMs = BLogQueryArgs::parseTime(from, newestMs)) < 0) {
+            std::cerr << "Invalid time: " << from << "\n";
+            return usage();
+        }
+        if(!to.empty() && (query.toMs = BLogQueryArgs::parseEnd(to, newestMs)) < 0) {
+            std::cerr << "Invalid time: " << to << "\n";
+            return usage();
+        }
+
+        auto ranges = index.query(query);
+
+        int fd = ::open(logPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0) {
+            std::cerr << "Could not open log file: " << logPath << " (" << std::strerror(errno) << ")\n";
+            return 1;
+        }
+        struct stat info;
+        ::fstat(fd, &info);
+        size_t logBytes = static_cast<size_t>(info.st_size);
+        size_t printed = 0;
+        size_t unindexed = 0;
+        if(logBytes > index.indexedEnd()) {
+            unindexed = logBytes - index.indexedEnd();
+            ranges.emplace_back(index.indexedEnd(), unindexed);
+        }
+        if(logBytes > 0) {
+            void* log = ::mmap(nullptr, logBytes, PROT_READ, MAP_SHARED, fd, 0);
+            if(log == MAP_FAILED) {
+                std::cerr << "Could not map log file: " << logPath << "\n";
+                ::close(fd);
+                return 1;
+            }
+            for(const auto& [offset, length] : ranges) {
+                if(offset >= logBytes)
+                    continue;
+                size_t available = std::min<size_t>(length, logBytes - offset);
+                ::madvise(static_cast<char*>(log) + (offset & ~uint64_t(4095)), available + (offset & 4095), MADV_SEQUENTIAL);
+                std::fwrite(static_cast<const char*>(log) + offset, 1, available, stdout);
+                printed += available;
+            }
+            ::munmap(log, logBytes);
+        }
+        ::close(fd);
+        std::fflush(stdout);
+
+        if(stats) {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+            std::cerr << index.size() << " blocks indexed, " << ranges.size() << " ranges matched, "
+                      << printed << " of " << logBytes << " bytes read (" << unindexed << " unindexed), " << ms << " ms\n";
+        }
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#ifndef BLOGQUERY_HPP
+#define BLOGQUERY_HPP
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+#include <time.h>
+
+#include "../include/logger/bloggerConfig.hpp"
+
+// Parsing of the blogquery Arguments, kept apart from main() so the Tests can use it
+class BLogQueryArgs {
+    public:
+        static bool parseLevel(const std::string& text, BLogLevel& level) {
+            for(const auto& [candidate, name] : LEVEL_TO_STRING) {
+                if(name == text) {
+                    level = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Milliseconds since the Epoch, -1 if the Text is no Time. referenceMs gives the Day for "HH:MM[:SS]"
+        static int64_t parseTime(const std::string& text, int64_t referenceMs) {
+            if(!text.empty() && text.find_first_not_of("0123456789") == std::string::npos)
+                return std::stoll(text) * 1000;
+
+            std::tm parsed{};
+            const char* end = ::strptime(text.c_str(), "%Y-%m-%d %H:%M:%S", &parsed);
+            if(!end || *end)
+                end = ::strptime(text.c_str(), "%Y-%m-%d %H:%M", &(parsed = std::tm{}));
+            if(!end || *end) {
+                std::time_t reference = static_cast<std::time_t>(referenceMs / 1000);
+                ::localtime_r(&reference, &parsed);
+                parsed.tm_sec = 0;
+                end = ::strptime(text.c_str(), "%H:%M:%S", &parsed);
+                if(!end || *end)
+                    end = ::strptime(text.c_str(), "%H:%M", &parsed);
+            }
+            if(!end || *end)
+                return -1;
+            parsed.tm_isdst = -1;
+            return static_cast<int64_t>(std::mktime(&parsed)) * 1000;
+        }
+
+        // Same for --to, but a Minute given as "10:05" means up to the End of that Minute
+        static int64_t parseEnd(const std::string& text, int64_t referenceMs) {
+            int64_t end = parseTime(text, referenceMs);
+            if(end >= 0 && text.find(':') != std::string::npos && text.find(':') == text.rfind(':'))
+                end += 59999;
+            return end;
+        }
+};
+
+#endif